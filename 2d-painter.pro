@@ -35,8 +35,7 @@ SOURCES += main.cpp \
 HEADERS  += mainwindow.h \
     ges/surface.hpp \
     ges/pixel_format.hpp \
-    ges/surface/surface_l1.hpp \
-    ges/surface/surface_l4.hpp \
+    ges/surface/surface_packed.hpp \
     ges/pixel_buffer.hpp \
     qdisplay.hpp \
     ges/pixel_color.hpp \
@@ -44,8 +43,21 @@ HEADERS  += mainwindow.h \
     ges/geometry/size.hpp \
     ges/geometry/line.hpp \
     ges/geometry/rect.hpp \
+    ges/geometry/rounded_rect.hpp \
     ges/painter.hpp \
+    ges/painter_statistics.hpp \
+    ges/trace.hpp \
+    ges/compositor.hpp \
+    ges/frame.hpp \
     ges/geometry/circle.hpp \
+    ges/geometry/angle_range.hpp \
+    ges/geometry/region.hpp \
+    ges/geometry/transform.hpp \
+    ges/image/rle_image.hpp \
+    ges/image/rle_encoder.hpp \
+    ges/image/asset_pack.hpp \
+    ges/image/asset_writer.hpp \
+    ges/image/asset_file.hpp \
     ges/pixel_color/pixel_color_rgb8.hpp \
     ges/pixel_color/pixel_color_l1.hpp \
     ges/pixel_color/pixel_color_l2.hpp \
@@ -55,11 +67,15 @@ HEADERS  += mainwindow.h \
     ges/pixel_color/pixel_color_rgb565.hpp \
     ges/pixel_color/pixel_color_rgb4.hpp \
     ges/pixel_color/pixel_color_rgb332.hpp \
+    ges/pixel_color/pixel_color_i4.hpp \
+    ges/pixel_color/pixel_color_i8.hpp \
+    ges/pixel_color/palette.hpp \
     ges/painter_impl.hpp \
     ges/geometry/ellipse.hpp \
     ges/color.hpp \
     ges/ges.hpp \
     ges/math/fixed_point.hpp \
+    ges/math/fixed_point_array.hpp \
     ges/math/test/fixed_point_test.hpp
 
 FORMS    += mainwindow.ui
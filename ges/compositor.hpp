@@ -0,0 +1,207 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_COMPOSITOR_HPP
+#define MODM_GES_COMPOSITOR_HPP
+
+#include <stdint.h>
+#include "surface.hpp"
+#include "painter.hpp"
+#include "geometry/region.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Composes a stack of layers into the output surface, bottom layer first.
+// Layers can be surfaces of any pixel format, which are not copied.
+// Only the damaged areas of the output are composed again, which are
+// collected from changes to layer properties and from `invalidate()`.
+template< PixelFormat Format, uint8_t Capacity = 8 >
+class Compositor
+{
+public:
+	using NativePainter = Painter<Format>;
+	using AlphaColor = typename NativePainter::AlphaColor;
+	using CompositionOperator = typename NativePainter::CompositionOperator;
+
+public:
+	Compositor(Surface<Format> &output, const AlphaColor background = AlphaColor(kColorBlack)) :
+		painter(output), bounds(output.getBounds()), background(background), count(0)
+	{
+		invalidate();
+	}
+
+	// returns the index of the new top layer, or -1 if there is no space
+	template< PixelFormat LayerFormat >
+	int8_t
+	addLayer(const Surface<LayerFormat> &surface, const Point &position, const uint8_t opacity = 0xff,
+			 const CompositionOperator composition = NativePainter::AoverB)
+	{
+		if (count >= Capacity) return -1;
+
+		Layer &layer = layers[count];
+		layer.surface = &surface;
+		layer.draw = &drawLayer<LayerFormat>;
+		layer.area = Rect(position, surface.getSize() - Size(1, 1));
+		layer.opacity = opacity;
+		layer.composition = composition;
+		layer.isVisible = true;
+
+		damage(layer.area);
+		return count++;
+	}
+
+	inline uint8_t
+	getLayerCount() const
+	{ return count; }
+
+
+	// changes to layer properties damage the affected area
+	void
+	setPosition(uint8_t index, const Point &position)
+	{
+		Layer &layer = layers[index];
+		damage(layer.area);
+		layer.area.moveTo(position);
+		damage(layer.area);
+	}
+
+	void
+	setOpacity(uint8_t index, const uint8_t opacity)
+	{
+		if (layers[index].opacity == opacity) return;
+		layers[index].opacity = opacity;
+		damage(layers[index].area);
+	}
+
+	void
+	setComposition(uint8_t index, const CompositionOperator composition)
+	{
+		layers[index].composition = composition;
+		damage(layers[index].area);
+	}
+
+	void
+	setVisible(uint8_t index, bool visible)
+	{
+		if (layers[index].isVisible == visible) return;
+		layers[index].isVisible = visible;
+		damage(layers[index].area);
+	}
+
+	inline Rect
+	getArea(uint8_t index) const
+	{ return layers[index].area; }
+
+
+	// marks an area of the layer as changed, in layer coordinates
+	void
+	invalidate(uint8_t index, const Rect &area)
+	{
+		const Rect &layer = layers[index].area;
+		const Rect moved(area.getOrigin() + layer.getOrigin(), area.getSize());
+		if (moved.intersects(layer)) damage(moved.intersected(layer));
+	}
+
+	// marks the whole layer as changed
+	void
+	invalidate(uint8_t index)
+	{ damage(layers[index].area); }
+
+	// marks the whole output as changed
+	void
+	invalidate()
+	{ damaged = Region(bounds); }
+
+	inline const Region &
+	getDamage() const
+	{ return damaged; }
+
+
+#ifdef MODM_GES_TRACE
+	// records composition and layers as events, next to the primitives of the painter
+	inline void
+	setTrace(Trace *trace)
+	{ painter.setTrace(trace); }
+#endif
+
+	// composes all damaged areas and returns false if there were none
+	bool
+	compose()
+	{
+		if (damaged.isEmpty()) return false;
+#ifdef MODM_GES_TRACE
+		const TraceScope scope(painter.getTrace(), "compose", TraceCategory::Frame);
+#endif
+
+		painter.setClipRegion(damaged);
+		painter.fillRect(bounds, background, NativePainter::A);
+
+		const Rect extent = damaged.getBounds();
+		for (uint8_t ii = 0; ii < count; ii++)
+		{
+			const Layer &layer = layers[ii];
+			if (layer.isVisible and layer.area.intersects(extent) and damaged.intersects(layer.area))
+			{
+#ifdef MODM_GES_TRACE
+				const TraceScope scope(painter.getTrace(), "layer", TraceCategory::Blit);
+#endif
+				layer.draw(painter, layer);
+			}
+		}
+
+		painter.resetClipArea();
+		damaged.clear();
+		return true;
+	}
+
+protected:
+	struct Layer
+	{
+		const void *surface;
+		void (*draw)(NativePainter &painter, const Layer &layer);
+		Rect area;
+		uint8_t opacity;
+		CompositionOperator composition;
+		bool isVisible;
+	};
+
+	template< PixelFormat LayerFormat >
+	static void
+	drawLayer(NativePainter &painter, const Layer &layer)
+	{
+		const Surface<LayerFormat> &surface = *static_cast<const Surface<LayerFormat>*>(layer.surface);
+		if (layer.opacity == 0xff)
+			painter.drawImage(surface, surface.getBounds(), layer.area.getOrigin(), layer.composition);
+		else
+			painter.drawImage(surface, surface.getBounds(), layer.area.getOrigin(), layer.opacity, layer.composition);
+	}
+
+	void
+	damage(const Rect &area)
+	{
+		if (not area.isValid() or not area.intersects(bounds)) return;
+		damaged.uniteOrBound(area.intersected(bounds));
+	}
+
+private:
+	NativePainter painter;
+	const Rect bounds;
+	const AlphaColor background;
+	Region damaged;
+	Layer layers[Capacity];
+	uint8_t count;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_COMPOSITOR_HPP
@@ -0,0 +1,134 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_FRAME_HPP
+#define MODM_GES_FRAME_HPP
+
+#include <stdint.h>
+#include "surface.hpp"
+#include "painter.hpp"
+#include "geometry/region.hpp"
+
+#ifndef MODM_GES_DAMAGE
+#	error "Frames need the damage recorded by the painter, define MODM_GES_DAMAGE!"
+#endif
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Clears only what was drawn since the last frame, instead of the whole surface.
+// The painter records the bounds of its primitives as damage, which `clear()`
+// restores to the background color or image. If the damage covers more than
+// `threshold / 256` of the surface, the whole surface is cleared at once.
+// Requires the painter to be built with MODM_GES_DAMAGE.
+template< PixelFormat Format >
+class Frame
+{
+public:
+	using NativePainter = Painter<Format>;
+	using NativeSurface = Surface<Format>;
+	using NativeColor = PixelColor<Format>;
+
+public:
+	Frame(NativePainter &painter, const NativeColor background, const uint8_t threshold = 128) :
+		painter(painter), surface(painter.getSurface()), image(nullptr), background(background), threshold(threshold)
+	{
+		painter.setDamage(&damaged);
+		invalidate();
+	}
+
+	// the image must have the size of the surface and stay valid
+	Frame(NativePainter &painter, const NativeSurface &background, const uint8_t threshold = 128) :
+		painter(painter), surface(painter.getSurface()), image(&background), background(), threshold(threshold)
+	{
+		painter.setDamage(&damaged);
+		invalidate();
+	}
+
+	~Frame()
+	{
+		if (painter.getDamage() == &damaged) painter.setDamage(nullptr);
+	}
+
+	// restores the damage to the background and starts collecting the next frame
+	void
+	clear()
+	{
+		if (damaged.isEmpty()) return;
+
+		if (getArea(damaged) * 256 > uint32_t(surface.getWidth()) * surface.getHeight() * threshold)
+		{
+			if (image) restore(surface.getBounds());
+			else surface.clear(background);
+		}
+		else for (uint8_t ii = 0; ii < damaged.getRectCount(); ii++)
+		{
+			restore(damaged.getRect(ii));
+		}
+		damaged.clear();
+	}
+
+	// marks an area written outside of the painter
+	void
+	damage(const Rect &area)
+	{
+		const Rect bounds = surface.getBounds();
+		if (not area.isValid() or not area.intersects(bounds)) return;
+		damaged.uniteOrBound(area.intersected(bounds));
+	}
+
+	// the whole surface is cleared on the next frame
+	void
+	invalidate()
+	{ damaged = Region(surface.getBounds()); }
+
+	inline const Region &
+	getDamage() const
+	{ return damaged; }
+
+protected:
+	static uint32_t
+	getArea(const Region &region)
+	{
+		uint32_t area = 0;
+		for (uint8_t ii = 0; ii < region.getRectCount(); ii++)
+		{
+			const Rect rect = region.getRect(ii);
+			area += (uint32_t(rect.getWidth()) + 1) * (uint32_t(rect.getHeight()) + 1);
+		}
+		return area;
+	}
+
+	void
+	restore(const Rect &area)
+	{
+		for (int16_t y = area.getTop(); y <= int16_t(area.getBottom()); y++)
+		{
+			if (image)
+				surface.copySpan(y, area.getLeft(), *image, area.getLeft(), y, area.getWidth() + 1);
+			else
+				surface.fillSpan(y, area.getLeft(), area.getRight(), background);
+		}
+	}
+
+private:
+	NativePainter &painter;
+	NativeSurface &surface;
+	const NativeSurface *const image;
+	const NativeColor background;
+	const uint8_t threshold;
+	Region damaged;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_FRAME_HPP
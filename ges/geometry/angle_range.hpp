@@ -0,0 +1,212 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_ANGLE_RANGE_HPP
+#define MODM_GES_ANGLE_RANGE_HPP
+
+#include <stdint.h>
+#include <xpcc/math/utils/misc.hpp>
+#include "../ges.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Angles swept clockwise on screen from the start to the end angle, as used by
+// arcs and pies. Ranges of a full turn or more cover the whole circle, equal
+// start and end angles cover nothing.
+// Offsets from the circle origin are tested with cross products against the
+// start and end directions, so no trigonometry is needed per pixel.
+class AngleRange
+{
+public:
+	enum class
+	Coverage : uint8_t
+	{
+		None,
+		Partial,
+		Full,
+	};
+
+	// octants are numbered clockwise on screen, starting at the positive x axis
+	static constexpr uint8_t Octants = 8;
+
+	// limit of spans, which leaves room for adding coordinates
+	static constexpr int16_t Unbounded = 0x3fff;
+
+public:
+	AngleRange(angle_t start, angle_t end)
+	{
+		int32_t sweep = end.value() - start.value();
+		isComplete = (sweep >= Tau or sweep <= -Tau);
+		sweep %= Tau;
+		if (sweep < 0) sweep += Tau;
+		if (isComplete) sweep = Tau;
+
+		int32_t begin = start.value() % Tau;
+		if (begin < 0) begin += Tau;
+
+		isConvex = (sweep <= Pi);
+		isVoid = (sweep == 0);
+		startX = ::cos(start).value(); startY = ::sin(start).value();
+		endX = ::cos(end).value(); endY = ::sin(end).value();
+
+		// The octants are classified with a margin, since the directions
+		// are only approximations of the angles. Pixels close to the octant
+		// borders are then tested exactly.
+		for (uint8_t octant = 0; octant < Octants; octant++)
+		{
+			Coverage coverage = Coverage::None;
+			if (isComplete) coverage = Coverage::Full;
+			else if (not isVoid) for (int32_t shift = -Tau; shift <= Tau; shift += Tau)
+			{
+				const int32_t low = (octant * Tau) / Octants + shift;
+				const int32_t high = ((octant + 1) * Tau) / Octants + shift;
+				if (begin + Margin <= low and high <= begin + sweep - Margin)
+				{
+					coverage = Coverage::Full;
+					break;
+				}
+				if (high >= begin - Margin and low <= begin + sweep + Margin)
+					coverage = Coverage::Partial;
+			}
+			coverages[octant] = coverage;
+		}
+	}
+
+	inline bool
+	isEmpty() const
+	{ return isVoid; }
+
+	inline bool
+	isFull() const
+	{ return isComplete; }
+
+	inline Coverage
+	getCoverage(uint8_t octant) const
+	{ return coverages[octant]; }
+
+	// coverage of the octants `begin` up to `end`
+	inline Coverage
+	combine(uint8_t begin, uint8_t end) const
+	{
+		const Coverage first = coverages[begin];
+		for (uint8_t octant = begin + 1; octant < end; octant++)
+			if (coverages[octant] != first) return Coverage::Partial;
+		return first;
+	}
+
+	// coverage of the row at the offset dy from the origin
+	inline Coverage
+	getRowCoverage(int16_t dy) const
+	{
+		if (dy > 0) return combine(0, Octants / 2);
+		if (dy < 0) return combine(Octants / 2, Octants);
+		return combine(0, Octants);
+	}
+
+	// coverage of the right or left half of the row at the offset dy
+	inline Coverage
+	getRowCoverage(int16_t dy, bool right) const
+	{
+		if (dy > 0) return right ? combine(0, Octants / 4) : combine(Octants / 4, Octants / 2);
+		if (dy < 0) return right ? combine(Octants * 3 / 4, Octants) : combine(Octants / 2, Octants * 3 / 4);
+		return combine(0, Octants);
+	}
+
+	inline bool
+	contains(int16_t dx, int16_t dy) const
+	{
+		if (isComplete) return true;
+		if (isVoid) return false;
+		if (isConvex)
+			return cross(startX, startY, dx, dy) >= 0 and cross(endX, endY, dx, dy) <= 0;
+		// outside of the complementary convex range
+		return not (cross(endX, endY, dx, dy) > 0 and cross(startX, startY, dx, dy) < 0);
+	}
+
+	// The x offsets of the row at the offset dy that are contained in the range
+	// are the span from begin to end, or all others if the span is inverted.
+	// This gives exactly the same result as `contains()` for every pixel.
+	struct Span
+	{
+		int16_t begin;
+		int16_t end;
+		bool inverted;
+	};
+
+	inline Span
+	getSpan(int16_t dy) const
+	{
+		int32_t begin = -Unbounded, end = Unbounded;
+		if (isComplete)
+			return {int16_t(begin), int16_t(end), false};
+		if (isVoid)
+			return {1, 0, false};
+		if (isConvex)
+		{
+			// startY * dx <= startX * dy and endY * dx >= endX * dy
+			limit(startY, startX * dy, false, begin, end);
+			limit(-endY, -endX * dy, false, begin, end);
+		}
+		else
+		{
+			// endY * dx < endX * dy and startY * dx > startX * dy
+			limit(endY, endX * dy, true, begin, end);
+			limit(-startY, -startX * dy, true, begin, end);
+		}
+		// empty spans stay empty
+		return {int16_t(xpcc::min(begin, int32_t(Unbounded))), int16_t(xpcc::max(end, int32_t(-Unbounded))), not isConvex};
+	}
+
+protected:
+	static constexpr int32_t Pi = 205887;		// in Q16
+	static constexpr int32_t Tau = 411775;
+	static constexpr int32_t Margin = 16;
+
+	// z component of (x, y) x (dx, dy)
+	static inline int32_t
+	cross(int32_t x, int32_t y, int16_t dx, int16_t dy)
+	{ return x * dy - y * dx; }
+
+	// limits [begin, end] to the integers x with a * x <= b, or a * x < b if strict
+	static inline void
+	limit(int32_t a, int32_t b, bool strict, int32_t &begin, int32_t &end)
+	{
+		if (a == 0)
+		{
+			if (strict ? (b <= 0) : (b < 0)) { begin = 1; end = 0; }
+		}
+		else if (a > 0)
+			end = xpcc::min(end, strict ? -floorDivide(-b, a) - 1 : floorDivide(b, a));
+		else
+			begin = xpcc::max(begin, strict ? floorDivide(b, a) + 1 : -floorDivide(-b, a));
+	}
+
+	static inline int32_t
+	floorDivide(int32_t a, int32_t b)
+	{
+		const int32_t quotient = a / b;
+		return ((a % b != 0) and ((a < 0) != (b < 0))) ? quotient - 1 : quotient;
+	}
+
+private:
+	Coverage coverages[Octants];
+	int32_t startX, startY;
+	int32_t endX, endY;
+	bool isComplete;
+	bool isConvex;
+	bool isVoid;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_ANGLE_RANGE_HPP
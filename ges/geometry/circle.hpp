@@ -144,8 +144,8 @@ public:
 	inline bool
 	intersects(const Circle &c) const
 	{
-		coord_t r = radius + c.radius;
-		return (origin.distanceSquared(c.origin) <= uint16_t(r * r));
+		wide_coord_t r = wide_coord_t(radius) + wide_coord_t(c.radius);
+		return (wide_coord_t(origin.distanceSquared(c.origin)) <= r * r);
 		// well... that was simple.
 	}
 
@@ -203,13 +203,13 @@ public:
 			switch(corner)
 			{
 				case 0b0011:	// top right corner
-					return contains(r.getTopRight());
+					return reaches(r.getTopRight());
 				case 0b0110:	// top left corner
-					return contains(r.getTopLeft());
+					return reaches(r.getTopLeft());
 				case 0b1100:	// bottom left corner
-					return contains(r.getBottomLeft());
+					return reaches(r.getBottomLeft());
 				case 0b1001:	// bottom right corner
-					return contains(r.getBottomRight());
+					return reaches(r.getBottomRight());
 				default:		// origin is to the left or right but vertically in the middle
 					break;
 			}
@@ -222,6 +222,12 @@ public:
 	inline bool operator != (const Circle &rhs) const
 	{ return (origin != rhs.origin or radius != rhs.radius); }
 
+protected:
+	// the rasterized circle covers pixels up to half a pixel beyond the radius
+	inline bool
+	reaches(const Point &point) const
+	{ return wide_coord_t(origin.distanceSquared(point)) <= (wide_coord_t(radius) + 1) * (wide_coord_t(radius) + 1); }
+
 private:
 	Point origin;
 	coord_t radius{0};
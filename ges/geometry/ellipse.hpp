@@ -243,13 +243,13 @@ public:
 			switch(corner)
 			{
 				case 0b0011:	// top right corner
-					return contains(r.getTopRight());
+					return reaches(r.getTopRight());
 				case 0b0110:	// top left corner
-					return contains(r.getTopLeft());
+					return reaches(r.getTopLeft());
 				case 0b1100:	// bottom left corner
-					return contains(r.getBottomLeft());
+					return reaches(r.getBottomLeft());
 				case 0b1001:	// bottom right corner
-					return contains(r.getBottomRight());
+					return reaches(r.getBottomRight());
 				default:		// origin is to the left or right but vertically in the middle
 					break;
 			}
@@ -262,6 +262,12 @@ public:
 	inline bool operator != (const Ellipse &rhs) const
 	{ return (origin != rhs.origin or size != rhs.size); }
 
+protected:
+	// the rasterized ellipse covers pixels up to half a pixel beyond its outline
+	inline bool
+	reaches(const Point &point) const
+	{ return Ellipse(origin - Point(1, 1), size + Size(2, 2)).contains(point); }
+
 private:
 	Point origin;
 	Size size;
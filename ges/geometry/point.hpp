@@ -84,10 +84,10 @@ public:
 	{
 		// not using `xpcc::Vector::getLengthSquared()` to avoid float type
 		Point d = point2 - point1;
-		return (int32_t(d.getX()) * d.getX() + int32_t(d.getY()) * d.getY());
+		return (int32_t(d.getX()) * int32_t(d.getX()) + int32_t(d.getY()) * int32_t(d.getY()));
 	}
 
-	inline uint16_t
+	inline uint32_t
 	distanceSquared(const Point &point) const
 	{
 		return Point::distanceSquared(*this, point);
@@ -185,7 +185,7 @@ public:
 
 	inline Point
 	getTopRight() const
-	{ return Point(getTop(), getRight()); }
+	{ return Point(getRight(), getTop()); }
 
 	inline Point
 	getBottomLeft() const
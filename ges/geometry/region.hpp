@@ -0,0 +1,342 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_REGION_HPP
+#define MODM_GES_REGION_HPP
+
+#include <stdint.h>
+#include <algorithm>
+#include "point.hpp"
+#include "rect.hpp"
+#include "../pixel_format.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// A set of non-overlapping rectangles in y-x banded order, like X11 and pixman
+// regions: rectangles are grouped into bands of equal top and bottom and
+// sorted left to right within a band. Identical adjacent bands are merged.
+// There is no heap, so operations exceeding the `Capacity` return false and
+// leave the region unchanged.
+class Region
+{
+public:
+	static constexpr uint8_t Capacity = 32;
+
+public:
+	inline Region() = default;
+	inline Region(const Region&) = default;
+
+	inline
+	Region(const Rect &rect)
+	{
+		if (rect.isValid())
+		{
+			boxes[0] = Box{int16_t(rect.getLeft()), int16_t(rect.getTop()),
+						   int16_t(rect.getRight()), int16_t(rect.getBottom())};
+			count = 1;
+		}
+	}
+
+
+	inline bool
+	isEmpty() const
+	{ return count == 0; }
+
+	inline void
+	clear()
+	{ count = 0; }
+
+
+	inline uint8_t
+	getRectCount() const
+	{ return count; }
+
+	inline Rect
+	getRect(uint8_t index) const
+	{ return boxes[index].toRect(); }
+
+	inline Rect
+	getBounds() const
+	{
+		if (isEmpty()) return Rect();
+
+		int16_t left = boxes[0].left;
+		int16_t right = boxes[0].right;
+		for (uint8_t ii = 1; ii < count; ii++)
+		{
+			left  = std::min(left,  boxes[ii].left);
+			right = std::max(right, boxes[ii].right);
+		}
+		return Rect(Point(left, boxes[0].top), Point(right, boxes[count-1].bottom));
+	}
+
+
+	inline void
+	translate(int16_t dx, int16_t dy)
+	{
+		for (uint8_t ii = 0; ii < count; ii++)
+		{
+			boxes[ii].left += dx; boxes[ii].right  += dx;
+			boxes[ii].top  += dy; boxes[ii].bottom += dy;
+		}
+	}
+
+	inline void
+	translate(const Point &offset)
+	{ translate(offset.getX(), offset.getY()); }
+
+
+	// contains
+	inline bool
+	contains(const Point &point) const
+	{ return contains(point.getX(), point.getY()); }
+
+	inline bool
+	contains(int16_t x, int16_t y) const
+	{
+		uint8_t end;
+		for (uint8_t ii = findBand(y, end); ii < end; ii++)
+		{
+			if (x < boxes[ii].left) return false;
+			if (x <= boxes[ii].right) return true;
+		}
+		return false;
+	}
+
+
+	// intersections
+	inline bool
+	intersects(const Rect &r) const
+	{
+		const int16_t left = r.getLeft(), top = r.getTop();
+		const int16_t right = r.getRight(), bottom = r.getBottom();
+		for (uint8_t ii = 0; ii < count and boxes[ii].top <= bottom; ii++)
+		{
+			if (not (boxes[ii].left > right or boxes[ii].right < left or boxes[ii].bottom < top))
+				return true;
+		}
+		return false;
+	}
+
+
+	// set operations
+	inline bool
+	unite(const Region &other)
+	{ return combine(other, Operation::Union); }
+
+	inline bool
+	intersect(const Region &other)
+	{ return combine(other, Operation::Intersection); }
+
+	inline bool
+	subtract(const Region &other)
+	{ return combine(other, Operation::Subtraction); }
+
+	inline bool
+	unite(const Rect &rect)
+	{ return unite(Region(rect)); }
+
+	inline bool
+	intersect(const Rect &rect)
+	{ return intersect(Region(rect)); }
+
+	inline bool
+	subtract(const Rect &rect)
+	{ return subtract(Region(rect)); }
+
+	// a union too complex for this region is simplified to its bounding rectangle
+	inline void
+	uniteOrBound(const Rect &rect)
+	{
+		if (not unite(rect))
+			*this = Region(getBounds().united(rect));
+	}
+
+protected:
+	// all coordinates are inclusive, just like `Rect`
+	struct Box
+	{
+		int16_t left;
+		int16_t top;
+		int16_t right;
+		int16_t bottom;
+
+		inline Rect
+		toRect() const
+		{ return Rect(Point(left, top), Point(right, bottom)); }
+	};
+
+	enum class
+	Operation : uint8_t
+	{
+		Union,
+		Intersection,
+		Subtraction,
+	};
+
+	// returns the first box of the band containing y, or of the band below it
+	inline uint8_t
+	findBand(int16_t y, uint8_t &end) const
+	{
+		// the bottoms of the bands increase monotonically
+		const Box *box = std::lower_bound(boxes, boxes + count, y,
+				[](const Box &b, int16_t y) { return b.bottom < y; });
+		uint8_t begin = box - boxes;
+		end = begin;
+		if (begin < count and boxes[begin].top <= y)
+		{
+			while (end < count and boxes[end].top == boxes[begin].top) end++;
+		}
+		return begin;
+	}
+
+	inline uint8_t
+	getBandEnd(uint8_t begin) const
+	{
+		uint8_t end = begin;
+		while (end < count and boxes[end].top == boxes[begin].top) end++;
+		return end;
+	}
+
+	// appends the spans of one band, or merges them with the identical band above
+	inline bool
+	appendBand(uint8_t &previous, int16_t top, int16_t bottom, const Box *spans, uint8_t size)
+	{
+		if (size == 0) return true;
+
+		if (previous < count and boxes[previous].bottom + 1 == top and count - previous == size)
+		{
+			bool identical = true;
+			for (uint8_t ii = 0; ii < size and identical; ii++)
+			{
+				identical = (boxes[previous + ii].left  == spans[ii].left and
+							 boxes[previous + ii].right == spans[ii].right);
+			}
+			if (identical)
+			{
+				for (uint8_t ii = previous; ii < count; ii++) boxes[ii].bottom = bottom;
+				return true;
+			}
+		}
+
+		if (count + size > Capacity) return false;
+
+		previous = count;
+		for (uint8_t ii = 0; ii < size; ii++)
+		{
+			boxes[count++] = Box{spans[ii].left, top, spans[ii].right, bottom};
+		}
+		return true;
+	}
+
+	static inline bool
+	isCovered(Operation operation, bool inA, bool inB)
+	{
+		switch(operation)
+		{
+			case Operation::Union:
+				return inA or inB;
+			case Operation::Intersection:
+				return inA and inB;
+			case Operation::Subtraction:
+			default:
+				return inA and not inB;
+		}
+	}
+
+	// combines the intervals of two bands in a single left-to-right sweep
+	static inline uint8_t
+	combineBand(Operation operation, const Box *a, const Box *aEnd, const Box *b, const Box *bEnd, Box *spans)
+	{
+		uint8_t size = 0;
+		int32_t x = INT16_MIN;
+
+		while (a < aEnd or b < bEnd)
+		{
+			while (a < aEnd and a->right < x) a++;
+			while (b < bEnd and b->right < x) b++;
+			if (a == aEnd and b == bEnd) break;
+
+			const bool inA = (a < aEnd and a->left <= x);
+			const bool inB = (b < bEnd and b->left <= x);
+
+			// the next position where the coverage of either band changes
+			int32_t next = int32_t(INT16_MAX) + 1;
+			if (a < aEnd) next = std::min(next, inA ? int32_t(a->right) + 1 : int32_t(a->left));
+			if (b < bEnd) next = std::min(next, inB ? int32_t(b->right) + 1 : int32_t(b->left));
+
+			if (isCovered(operation, inA, inB))
+			{
+				if (size and spans[size-1].right + 1 == x) {
+					spans[size-1].right = next - 1;
+				} else {
+					spans[size++] = Box{int16_t(x), 0, int16_t(next - 1), 0};
+				}
+			}
+			x = next;
+		}
+		return size;
+	}
+
+	inline bool
+	combine(const Region &other, Operation operation)
+	{
+		Region result;
+		Box spans[2 * Capacity];
+		uint8_t previous = Capacity;
+
+		uint8_t ia = 0, ib = 0;
+		int32_t y = INT16_MIN;
+
+		while (true)
+		{
+			// skip bands which are completely above the sweep line
+			while (ia < count and boxes[ia].bottom < y) ia = getBandEnd(ia);
+			while (ib < other.count and other.boxes[ib].bottom < y) ib = other.getBandEnd(ib);
+			if (ia >= count and ib >= other.count) break;
+
+			const bool inA = (ia < count and boxes[ia].top <= y);
+			const bool inB = (ib < other.count and other.boxes[ib].top <= y);
+
+			// the sweep line stops where either band begins or ends
+			int32_t bottom = INT16_MAX;
+			if (ia < count) bottom = std::min(bottom, inA ? int32_t(boxes[ia].bottom) : int32_t(boxes[ia].top) - 1);
+			if (ib < other.count) bottom = std::min(bottom, inB ? int32_t(other.boxes[ib].bottom) : int32_t(other.boxes[ib].top) - 1);
+
+			if (inA or inB)
+			{
+				const uint8_t aEnd = inA ? getBandEnd(ia) : ia;
+				const uint8_t bEnd = inB ? other.getBandEnd(ib) : ib;
+				const uint8_t size = combineBand(operation, boxes + ia, boxes + aEnd,
+												 other.boxes + ib, other.boxes + bEnd, spans);
+				if (size > Capacity or not result.appendBand(previous, y, bottom, spans, size))
+					return false;
+			}
+			y = bottom + 1;
+		}
+
+		*this = result;
+		return true;
+	}
+
+private:
+	Box boxes[Capacity];
+	uint8_t count{0};
+
+	template < PixelFormat F >
+	friend class Painter;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_REGION_HPP
@@ -0,0 +1,114 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_ROUNDED_RECT_HPP
+#define MODM_GES_ROUNDED_RECT_HPP
+
+#include "rect.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Rectangle with quarter circle corners of individual radii.
+// Radii larger than half the shorter side are limited to it.
+class RoundedRect
+{
+public:
+	enum
+	Corner : uint8_t
+	{
+		TopLeft = 0,
+		TopRight = 1,
+		BottomRight = 2,
+		BottomLeft = 3,
+	};
+
+public:
+	inline RoundedRect() = default;
+	inline RoundedRect(const RoundedRect&) = default;
+
+	inline
+	RoundedRect(const Rect &rect, coord_t radius) :
+		rect(rect), radii{radius, radius, radius, radius} {}
+
+	inline
+	RoundedRect(const Rect &rect, coord_t topLeft, coord_t topRight, coord_t bottomRight, coord_t bottomLeft) :
+		rect(rect), radii{topLeft, topRight, bottomRight, bottomLeft} {}
+
+
+	inline bool
+	isEmpty() const
+	{ return rect.isEmpty(); }
+
+	inline bool
+	isValid() const
+	{ return rect.isValid(); }
+
+
+	inline Rect
+	getBounds() const
+	{ return rect; }
+
+	inline Rect
+	getRect() const
+	{ return rect; }
+
+	inline void
+	setRect(const Rect &rect)
+	{ this->rect = rect; }
+
+
+	// getter radius, limited to half the shorter side
+	inline coord_t
+	getRadius(Corner corner) const
+	{
+		const coord_t limit = xpcc::min(rect.getWidth(), rect.getHeight()) / 2;
+		const coord_t radius = radii[corner];
+		if (radius <= coord_t(0)) return 0;
+		return (radius < limit) ? radius : limit;
+	}
+
+	// setter radius
+	inline void
+	setRadius(Corner corner, coord_t radius)
+	{ radii[corner] = radius; }
+
+	inline void
+	setRadius(coord_t radius)
+	{ radii[0] = radii[1] = radii[2] = radii[3] = radius; }
+
+
+	// translate
+	inline void
+	translate(coord_t dx, coord_t dy)
+	{ rect.translate(dx, dy); }
+
+	inline void
+	translate(const Point &offset)
+	{ rect.translate(offset); }
+
+	inline RoundedRect
+	translated(coord_t dx, coord_t dy) const
+	{ return RoundedRect(rect.translated(dx, dy), radii[0], radii[1], radii[2], radii[3]); }
+
+	inline RoundedRect
+	translated(const Point &offset) const
+	{ return RoundedRect(rect.translated(offset), radii[0], radii[1], radii[2], radii[3]); }
+
+private:
+	Rect rect;
+	coord_t radii[4]{0, 0, 0, 0};
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_ROUNDED_RECT_HPP
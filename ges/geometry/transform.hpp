@@ -0,0 +1,115 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_TRANSFORM_HPP
+#define MODM_GES_TRANSFORM_HPP
+
+#include <cmath>
+#include "point.hpp"
+#include "../math/fixed_point.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// 2x3 affine matrix, which maps (x, y) to (a*x + b*y + c, d*x + e*y + f).
+class
+Transform
+{
+public:
+	using value_t = modm::fix32_t<16>;
+
+public:
+	constexpr
+	Transform() :
+		a(1), b(0), c(0), d(0), e(1), f(0)
+	{}
+
+	constexpr
+	Transform(value_t a, value_t b, value_t c, value_t d, value_t e, value_t f) :
+		a(a), b(b), c(c), d(d), e(e), f(f)
+	{}
+
+	static constexpr Transform
+	translation(value_t x, value_t y)
+	{ return Transform(1, 0, x, 0, 1, y); }
+
+	static constexpr Transform
+	scaling(value_t x, value_t y)
+	{ return Transform(x, 0, 0, 0, y, 0); }
+
+	static constexpr Transform
+	shearing(value_t x, value_t y)
+	{ return Transform(1, x, 0, y, 1, 0); }
+
+	// clockwise on screen, since the y axis points down
+	static constexpr Transform
+	rotation(value_t sine, value_t cosine)
+	{ return Transform(cosine, -sine, 0, sine, cosine, 0); }
+
+	static inline Transform
+	rotation(float radians)
+	{ return rotation(std::sin(radians), std::cos(radians)); }
+
+	// without floating point
+	static constexpr Transform
+	rotation(value_t radians)
+	{ return rotation(::sin(radians), ::cos(radians)); }
+
+
+	// returns the transform applying `other` first, then this
+	constexpr Transform
+	operator * (const Transform &other) const
+	{
+		return Transform(a * other.a + b * other.d, a * other.b + b * other.e, a * other.c + b * other.f + c,
+						 d * other.a + e * other.d, d * other.b + e * other.e, d * other.c + e * other.f + f);
+	}
+
+	constexpr value_t
+	getDeterminant() const
+	{ return a * e - b * d; }
+
+	constexpr bool
+	isInvertible() const
+	{ return getDeterminant() != value_t(0); }
+
+	// only valid if invertible
+	constexpr Transform
+	inverted() const
+	{
+		return Transform( e / getDeterminant(), -b / getDeterminant(), (b * f - c * e) / getDeterminant(),
+						 -d / getDeterminant(),  a / getDeterminant(), (c * d - a * f) / getDeterminant());
+	}
+
+
+	inline value_t
+	mapX(value_t x, value_t y) const
+	{ return a * x + b * y + c; }
+
+	inline value_t
+	mapY(value_t x, value_t y) const
+	{ return d * x + e * y + f; }
+
+	inline Point
+	map(const Point &point) const
+	{
+		const value_t x = point.getX(), y = point.getY();
+		return Point(coord_t(mapX(x, y)), coord_t(mapY(x, y)));
+	}
+
+public:
+	value_t a, b, c;
+	value_t d, e, f;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_TRANSFORM_HPP
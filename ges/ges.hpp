@@ -18,13 +18,21 @@ namespace modm
 namespace ges
 {
 
+// overflow policy of coordinates, `Trap` helps finding overflows in debug builds
+#ifndef MODM_GES_COORDINATE_OVERFLOW
+#	define MODM_GES_COORDINATE_OVERFLOW Wrap
+#endif
+
 //using coord_t = int16_t;			// for      aliased lines
-using coord_t = modm::fix16_t<4>;	// for anti-aliased lines
+using coord_t = modm::fixed_point_t<int16_t, 4, modm::Overflow::MODM_GES_COORDINATE_OVERFLOW>;	// for anti-aliased lines
 //using coord_t = float;			// for  cyber-hyper lines
 
 using wide_coord_t = typename xpcc::ArithmeticTraits<coord_t>::WideType;
 using Vector  = xpcc::Vector<coord_t, 2>;
 
+// radians, clockwise on screen from the positive x axis
+using angle_t = modm::fix32_t<16>;
+
 }
 
 }
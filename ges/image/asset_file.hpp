@@ -0,0 +1,95 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_ASSET_FILE_HPP
+#define MODM_GES_ASSET_FILE_HPP
+
+#include "asset_pack.hpp"
+
+#ifdef XPCC__OS_HOSTED
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Maps an asset pack file read-only into memory on POSIX hosts.
+// The pages are loaded lazily by the kernel on first access and shared
+// between all processes using the same file.
+class AssetFile
+{
+public:
+	AssetFile() = default;
+
+	AssetFile(const char *path)
+	{ open(path); }
+
+	AssetFile(const AssetFile&) = delete;
+	AssetFile& operator=(const AssetFile&) = delete;
+
+	~AssetFile()
+	{ close(); }
+
+	bool
+	open(const char *path)
+	{
+		close();
+
+		const int fd = ::open(path, O_RDONLY);
+		if (fd < 0) return false;
+
+		struct stat status;
+		if (::fstat(fd, &status) == 0 and status.st_size > 0)
+		{
+			void *map = ::mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			if (map != MAP_FAILED)
+			{
+				mapping = map;
+				length = status.st_size;
+				pack = AssetPack(static_cast<const uint8_t*>(map), length);
+			}
+		}
+		// the mapping stays valid after closing the file
+		::close(fd);
+
+		if (not pack.isValid()) close();
+		return pack.isValid();
+	}
+
+	void
+	close()
+	{
+		if (mapping) ::munmap(mapping, length);
+		mapping = nullptr;
+		length = 0;
+		pack = AssetPack();
+	}
+
+	// the pack and all surfaces created by it are only valid while mapped
+	inline const AssetPack &
+	getPack() const
+	{ return pack; }
+
+private:
+	void *mapping{nullptr};
+	std::size_t length{0};
+	AssetPack pack;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // XPCC__OS_HOSTED
+
+#endif // MODM_GES_ASSET_FILE_HPP
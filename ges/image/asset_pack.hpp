@@ -0,0 +1,193 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_ASSET_PACK_HPP
+#define MODM_GES_ASSET_PACK_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include "rle_image.hpp"
+#include "../surface.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// A read-only container of named assets, which is either linked into flash or
+// memory mapped from a file, see `AssetFile`. Images are stored in the native
+// layout of their `PixelBuffer`, so surfaces are created directly on top of
+// the data without copying or decoding anything.
+//
+// Layout, all in native byte order and aligned to 4 bytes:
+// - Header: magic, version and number of entries.
+// - Index: one `Entry` per asset.
+// - Data: the pixels of every asset, each starting 4 byte aligned.
+class AssetPack
+{
+public:
+	static constexpr uint32_t Magic = 0x50534547; // "GESP"
+	static constexpr uint16_t Version = 1;
+	static constexpr uint8_t NameLength = 16;
+	static constexpr uint8_t Alignment = 4;
+
+	enum class
+	Encoding : uint8_t
+	{
+		Raw = 0,	// pixels in the layout of a `PixelBuffer`
+		Rle = 1,	// runs of an `RleImage`
+		Data = 2,	// anything else, like fonts
+	};
+
+	struct Header
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t count;
+	};
+
+	struct Entry
+	{
+		char name[NameLength];	// not terminated if all characters are used
+		uint32_t offset;		// from the beginning of the pack
+		uint32_t size;
+		uint16_t width;
+		uint16_t height;
+		uint8_t format;
+		Encoding encoding;
+		uint8_t bits;			// bits per pixel of the encoding platform
+		uint8_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 8, "Header must not be padded!");
+	static_assert(sizeof(Entry) == 32, "Entry must not be padded!");
+
+public:
+	AssetPack() :
+		data(nullptr), size(0)
+	{}
+
+	// the data must be aligned to 4 bytes
+	AssetPack(const uint8_t *const data, const std::size_t size) :
+		data(data), size(size)
+	{
+		if (not validate()) this->size = 0;
+	}
+
+	inline bool
+	isValid() const
+	{ return size != 0; }
+
+	inline uint16_t
+	getCount() const
+	{ return isValid() ? getHeader().count : 0; }
+
+	// returns the index of the asset or -1 if not found
+	int16_t
+	find(const char *name) const
+	{
+		for (uint16_t ii = 0; ii < getCount(); ii++)
+		{
+			if (std::strncmp(getEntry(ii).name, name, NameLength) == 0)
+				return ii;
+		}
+		return -1;
+	}
+
+	inline const Entry &
+	getEntry(uint16_t index) const
+	{ return reinterpret_cast<const Entry*>(data + sizeof(Header))[index]; }
+
+	inline const uint8_t *
+	getData(uint16_t index) const
+	{ return data + getEntry(index).offset; }
+
+	inline Size
+	getSize(uint16_t index) const
+	{ return Size(getEntry(index).width, getEntry(index).height); }
+
+	inline PixelFormat
+	getPixelFormat(uint16_t index) const
+	{ return PixelFormat(getEntry(index).format); }
+
+
+	// Surfaces must only be used as source, since the data is read-only.
+	// An empty surface is returned if the format or layout does not match.
+	template< PixelFormat Format >
+	Surface<Format>
+	getSurface(uint16_t index) const
+	{
+		if (not hasImage<Format>(index, Encoding::Raw))
+			return Surface<Format>(nullptr, 0, 0);
+
+		const Entry &entry = getEntry(index);
+		return Surface<Format>(const_cast<uint8_t*>(getData(index)), entry.width, entry.height);
+	}
+
+	// An empty image is returned if the format does not match.
+	template< PixelFormat Format >
+	RleImage<Format>
+	getRleImage(uint16_t index) const
+	{
+		if (not hasImage<Format>(index, Encoding::Rle))
+			return RleImage<Format>(0, 0, nullptr);
+
+		const Entry &entry = getEntry(index);
+		return RleImage<Format>(entry.width, entry.height, getData(index));
+	}
+
+protected:
+	inline const Header &
+	getHeader() const
+	{ return *reinterpret_cast<const Header*>(data); }
+
+	template< PixelFormat Format >
+	bool
+	hasImage(uint16_t index, Encoding encoding) const
+	{
+		if (index >= getCount()) return false;
+		const Entry &entry = getEntry(index);
+		return (entry.encoding == encoding and
+				PixelFormat(entry.format) == Format and
+				entry.bits == PixelColor<Format>::Bits);
+	}
+
+	bool
+	validate() const
+	{
+		if (data == nullptr or size < sizeof(Header)) return false;
+		if (reinterpret_cast<uintptr_t>(data) % Alignment) return false;
+
+		const Header &header = getHeader();
+		if (header.magic != Magic or header.version != Version) return false;
+		if (size < sizeof(Header) + std::size_t(header.count) * sizeof(Entry)) return false;
+
+		for (uint16_t ii = 0; ii < header.count; ii++)
+		{
+			const Entry &entry = getEntry(ii);
+			if (entry.offset % Alignment or entry.offset > size or
+				entry.size > size - entry.offset) return false;
+
+			// raw images must contain all their pixels
+			if (entry.encoding == Encoding::Raw and
+				entry.size < std::size_t(entry.width) * entry.height * entry.bits / 8) return false;
+		}
+		return true;
+	}
+
+private:
+	const uint8_t *data;
+	std::size_t size;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_ASSET_PACK_HPP
@@ -0,0 +1,134 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_ASSET_WRITER_HPP
+#define MODM_GES_ASSET_WRITER_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <ostream>
+#include "asset_pack.hpp"
+#include "../pixel_buffer.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Collects assets on the host and writes them as an `AssetPack`.
+// Pixel buffers have the same layout on hosted and embedded builds, so packs
+// written on a little endian host can be linked into the targets.
+class AssetWriter
+{
+	using Encoding = AssetPack::Encoding;
+
+public:
+	template< uint16_t Width, uint16_t Height, PixelFormat Format >
+	bool
+	add(const char *name, const PixelBuffer<Width, Height, Format> &buffer)
+	{
+		return add(name, Width, Height, Format, Encoding::Raw,
+				   PixelColor<Format>::Bits, buffer.getData(), buffer.getLength());
+	}
+
+	// data created by the `RleEncoder`
+	template< PixelFormat Format >
+	bool
+	add(const char *name, const Size size, const std::vector<uint8_t> &rle)
+	{
+		return add(name, size.getWidth(), size.getHeight(), Format, Encoding::Rle,
+				   PixelColor<Format>::Bits, rle.data(), rle.size());
+	}
+
+	bool
+	add(const char *name, const uint8_t *data, std::size_t size)
+	{ return add(name, 0, 0, PixelFormat(0), Encoding::Data, 0, data, size); }
+
+
+	std::vector<uint8_t>
+	write() const
+	{
+		AssetPack::Header header{AssetPack::Magic, AssetPack::Version, uint16_t(assets.size())};
+
+		std::vector<uint8_t> pack;
+		append(pack, &header, sizeof(header));
+
+		// the data follows the index
+		std::size_t offset = sizeof(AssetPack::Header) + assets.size() * sizeof(AssetPack::Entry);
+		for (const Asset &asset : assets)
+		{
+			offset = align(offset);
+			AssetPack::Entry entry = asset.entry;
+			entry.offset = offset;
+			append(pack, &entry, sizeof(entry));
+			offset += asset.data.size();
+		}
+		for (const Asset &asset : assets)
+		{
+			pack.resize(align(pack.size()), 0);
+			append(pack, asset.data.data(), asset.data.size());
+		}
+		return pack;
+	}
+
+	void
+	write(std::ostream &stream) const
+	{
+		const std::vector<uint8_t> pack = write();
+		stream.write(reinterpret_cast<const char*>(pack.data()), pack.size());
+	}
+
+protected:
+	struct Asset
+	{
+		AssetPack::Entry entry;
+		std::vector<uint8_t> data;
+	};
+
+	bool
+	add(const char *name, uint16_t width, uint16_t height, PixelFormat format,
+		Encoding encoding, uint8_t bits, const uint8_t *data, std::size_t size)
+	{
+		const std::size_t length = std::strlen(name);
+		if (length > AssetPack::NameLength or assets.size() >= UINT16_MAX)
+			return false;
+
+		Asset asset{};
+		std::memcpy(asset.entry.name, name, length);
+		asset.entry.size = size;
+		asset.entry.width = width;
+		asset.entry.height = height;
+		asset.entry.format = uint8_t(format);
+		asset.entry.encoding = encoding;
+		asset.entry.bits = bits;
+		asset.data.assign(data, data + size);
+		assets.push_back(std::move(asset));
+		return true;
+	}
+
+	static std::size_t
+	align(std::size_t offset)
+	{ return (offset + AssetPack::Alignment - 1) & ~std::size_t(AssetPack::Alignment - 1); }
+
+	static void
+	append(std::vector<uint8_t> &pack, const void *data, std::size_t size)
+	{
+		const uint8_t *bytes = static_cast<const uint8_t*>(data);
+		pack.insert(pack.end(), bytes, bytes + size);
+	}
+
+private:
+	std::vector<Asset> assets;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_ASSET_WRITER_HPP
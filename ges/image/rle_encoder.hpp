@@ -0,0 +1,144 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_RLE_ENCODER_HPP
+#define MODM_GES_RLE_ENCODER_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+#include "rle_image.hpp"
+#include "../surface.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Encodes surfaces into the `RleImage` format.
+// This uses the heap and is meant for the host, either to generate the image
+// data offline as source code, or to compress images at runtime.
+template< PixelFormat Format >
+class RleEncoder
+{
+public:
+	using Image = RleImage<Format>;
+	using NativeColor = typename Image::NativeColor;
+	using Type = typename Image::Type;
+	using Run = typename Image::Run;
+
+public:
+	// pixels with zero alpha become skip runs
+	static std::vector<uint8_t>
+	encode(const Surface<Format> &surface)
+	{
+		return encode(surface, [](const NativeColor pixel)
+		{ return static_cast<Color>(pixel).getAlpha() == 0; });
+	}
+
+	// pixels of the color key become skip runs
+	static std::vector<uint8_t>
+	encode(const Surface<Format> &surface, const NativeColor colorKey)
+	{
+		return encode(surface, [colorKey](const NativeColor pixel)
+		{ return pixel == colorKey; });
+	}
+
+	// writes the data as a C++ array definition
+	static void
+	write(std::ostream &stream, const char *name, const std::vector<uint8_t> &data)
+	{
+		stream << "static const uint8_t " << name << "[" << data.size() << "] =\n{";
+		for (std::size_t ii = 0; ii < data.size(); ii++)
+		{
+			if (ii % 16 == 0) stream << "\n\t";
+			stream << "0x" << std::hex << std::setw(2) << std::setfill('0')
+				   << int(data[ii]) << std::dec << ",";
+		}
+		stream << "\n};\n";
+	}
+
+protected:
+	template< typename Function >
+	static std::vector<uint8_t>
+	encode(const Surface<Format> &surface, Function &&isTransparent)
+	{
+		std::vector<uint8_t> data;
+
+		for (uint16_t y = 0; y < surface.getHeight(); y++)
+		{
+			const uint16_t width = surface.getWidth();
+			uint16_t x = 0;
+			while (x < width)
+			{
+				const NativeColor pixel = surface.getPixel(x, y);
+				const uint8_t length = getRepeatLength(surface, x, y);
+
+				if (isTransparent(pixel))
+				{
+					uint8_t skip = 1;
+					while (x + skip < width and skip < Image::MaxLength and
+						   isTransparent(surface.getPixel(x + skip, y))) skip++;
+					data.push_back(Image::getHeader(Run::Skip, skip));
+					x += skip;
+				}
+				else if (isSolid(length))
+				{
+					data.push_back(Image::getHeader(Run::Solid, length));
+					append(data, pixel);
+					x += length;
+				}
+				else
+				{
+					// collect pixels until the next transparent or solid run
+					uint8_t literal = 1;
+					while (x + literal < width and literal < Image::MaxLength and
+						   not isTransparent(surface.getPixel(x + literal, y)) and
+						   not isSolid(getRepeatLength(surface, x + literal, y))) literal++;
+					data.push_back(Image::getHeader(Run::Literal, literal));
+					for (uint8_t ii = 0; ii < literal; ii++)
+						append(data, surface.getPixel(x + ii, y));
+					x += literal;
+				}
+			}
+		}
+		return data;
+	}
+
+	static uint8_t
+	getRepeatLength(const Surface<Format> &surface, uint16_t x, uint16_t y)
+	{
+		const NativeColor pixel = surface.getPixel(x, y);
+		uint8_t length = 1;
+		while (x + length < surface.getWidth() and length < Image::MaxLength and
+			   surface.getPixel(x + length, y) == pixel) length++;
+		return length;
+	}
+
+	// two repeated pixels only save space if they are wider than the header
+	static constexpr bool
+	isSolid(const uint8_t length)
+	{ return length >= 3 or (length == 2 and sizeof(Type) > 1); }
+
+	static void
+	append(std::vector<uint8_t> &data, const NativeColor pixel)
+	{
+		const Type value = pixel.getValue();
+		uint8_t bytes[sizeof(Type)];
+		std::memcpy(bytes, &value, sizeof(Type));
+		data.insert(data.end(), bytes, bytes + sizeof(Type));
+	}
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_RLE_ENCODER_HPP
@@ -0,0 +1,132 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_RLE_IMAGE_HPP
+#define MODM_GES_RLE_IMAGE_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include "../pixel_format.hpp"
+#include "../pixel_color.hpp"
+#include "../geometry/size.hpp"
+#include "../geometry/rect.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// A read-only, run-length encoded image, usually stored in flash.
+// Every row is encoded on its own as a sequence of runs, each starting with
+// a header byte: the upper two bits select the kind of the run, the lower six
+// bits hold its length minus one. Solid runs are followed by one pixel value,
+// literal runs by one pixel value per pixel, skip runs by nothing at all.
+// Pixel values are stored as `Type` in the native byte order of the target.
+// Use the `RleEncoder` to create the data.
+template< PixelFormat Format >
+class RleImage
+{
+public:
+	using NativeColor = PixelColor<Format>;
+	using Type = typename NativeColor::Type;
+
+	enum class
+	Run : uint8_t
+	{
+		Skip = 0x00,	// the pixels are not drawn
+		Solid = 0x40,	// one pixel value repeated
+		Literal = 0x80,	// one pixel value per pixel
+	};
+	static constexpr uint8_t RunMask = 0xc0;
+	static constexpr uint8_t MaxLength = 64;
+
+public:
+	constexpr
+	RleImage(const uint16_t width, const uint16_t height, const uint8_t *const data) :
+		width(width), height(height), data(data)
+	{}
+
+	constexpr
+	RleImage(const Size size, const uint8_t *const data) :
+		RleImage(size.getWidth(), size.getHeight(), data)
+	{}
+
+	uint16_t
+	getWidth() const
+	{ return width; }
+
+	uint16_t
+	getHeight() const
+	{ return height; }
+
+	Size
+	getSize() const
+	{ return Size(width, height); }
+
+	Rect
+	getBounds() const
+	{ return Rect(0,0, width-1, height-1); }
+
+	static constexpr PixelFormat
+	getPixelFormat()
+	{ return Format; }
+
+	const uint8_t *
+	getData() const
+	{ return data; }
+
+
+	// decoding
+	static constexpr uint8_t
+	getHeader(const Run run, const uint8_t length)
+	{ return uint8_t(run) | (length - 1); }
+
+	static constexpr Run
+	getRun(const uint8_t header)
+	{ return Run(header & RunMask); }
+
+	static constexpr uint8_t
+	getLength(const uint8_t header)
+	{ return (header & ~RunMask) + 1; }
+
+	static inline NativeColor
+	getPixel(const uint8_t *pixel)
+	{
+		// the data is not necessarily aligned
+		Type value;
+		std::memcpy(&value, pixel, sizeof(Type));
+		return NativeColor(value);
+	}
+
+	// returns the header of the next run
+	static inline const uint8_t *
+	skipRun(const uint8_t *header)
+	{
+		switch(getRun(*header))
+		{
+			case Run::Solid:
+				return header + 1 + sizeof(Type);
+			case Run::Literal:
+				return header + 1 + getLength(*header) * sizeof(Type);
+			case Run::Skip:
+			default:
+				return header + 1;
+		}
+	}
+
+protected:
+	const uint16_t width;
+	const uint16_t height;
+	const uint8_t *const data;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_RLE_IMAGE_HPP
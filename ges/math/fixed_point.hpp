@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <stdint.h>
+#include <limits>
 #include <type_traits>
 
 #include <xpcc/utils/arithmetic_traits.hpp>
@@ -19,10 +20,22 @@
 namespace modm
 {
 
-template<typename U, uint8_t F>
+// What happens if a result does not fit into the underlying type:
+// - Wrap: the bits are truncated like for integers, which costs nothing.
+// - Saturate: the result is clamped to the minimum or maximum.
+// - Trap: the program is stopped, which helps finding overflows in debug builds.
+enum class
+Overflow : uint8_t
+{
+	Wrap,
+	Saturate,
+	Trap,
+};
+
+template<typename U, uint8_t F, Overflow O = Overflow::Wrap>
 class fixed_point_t
 {
-	template<typename, uint8_t>
+	template<typename, uint8_t, Overflow>
 	friend class fixed_point_t;
 
 	static_assert(F < sizeof(U) * 8, "Fractional size cannot be larger than underlying type!");
@@ -37,10 +50,60 @@ class fixed_point_t
 
 	using WideType = typename xpcc::ArithmeticTraits<U>::WideType;
 	template<typename RU, uint8_t RF>
-	using fpc_t = fixed_point_t<std::conditional_t<(sizeof(U) > sizeof(RU)), U, RU>, (F > RF ? F : RF)>;
+	using fpc_t = fixed_point_t<std::conditional_t<(sizeof(U) > sizeof(RU)), U, RU>, (F > RF ? F : RF), O>;
+
+	static constexpr U
+	overflow(const bool negative)
+	{
+		if (O == Overflow::Trap) __builtin_trap();
+		return negative ? std::numeric_limits<U>::min() : std::numeric_limits<U>::max();
+	}
+
+	// applies the overflow policy to an exact result of wider type
+	template<typename T>
+	static constexpr U
+	narrow(const T value)
+	{
+		if (value > 0 and uintmax_t(value) > uintmax_t(std::numeric_limits<U>::max())) return overflow(false);
+		if (value < 0 and  intmax_t(value) <  intmax_t(std::numeric_limits<U>::min())) return overflow(true);
+		return U(value);
+	}
+
+	// value * 2^shift with the overflow policy applied
+	template<typename T>
+	static constexpr U
+	shifted(const T value, const uint8_t shift)
+	{
+		if (value > 0 and uintmax_t(value) > (uintmax_t(std::numeric_limits<U>::max()) >> shift)) return overflow(false);
+		if (value < 0 and  intmax_t(value) < ( intmax_t(std::numeric_limits<U>::min()) >> shift)) return overflow(true);
+		return U(intmax_t(value) * (intmax_t(1) << shift));
+	}
+
+	// rounded like the constructor, with the overflow policy applied
+	template<typename T>
+	static constexpr U
+	scaled(const T value)
+	{
+		const T v = (value + ((value >= 0) ? halfeps : -halfeps)) * one;
+		// the conversion truncates towards zero
+		if (double(v) >= double(std::numeric_limits<U>::max()) + 1) return overflow(false);
+		if (double(v) <= double(std::numeric_limits<U>::min()) - 1) return overflow(true);
+		return U(v);
+	}
+
+	template<typename T>
+	static constexpr U
+	convert(const T value, std::true_type /* is_integral */)
+	{ return shifted(value, F); }
+
+	template<typename T>
+	static constexpr U
+	convert(const T value, std::false_type /* is_integral */)
+	{ return scaled(value); }
 
 public:
 	static constexpr uint8_t Fractions = F;
+	static constexpr Overflow Policy = O;
 	using UnderlyingType = U;
 
 public:
@@ -66,21 +129,26 @@ public:
 			  typename = std::enable_if_t< std::is_arithmetic<ArithmeticType>::value > >
 	constexpr fixed_point_t(const ArithmeticType value) :
 		ival(
-			std::is_integral<ArithmeticType>::value ?
+			O != Overflow::Wrap ?
+			convert(value, std::is_integral<ArithmeticType>()) :
+			U(std::is_integral<ArithmeticType>::value ?
 			// integer inputs experience no loss of precision
 			value * one :
 			// floating point inputs require rounding
-			(value + ((value >= 0) ? halfeps : -halfeps)) * one
+			(value + ((value >= 0) ? halfeps : -halfeps)) * one)
 		) {}
 
-	template<typename OU, uint8_t OF, typename = std::enable_if_t< (OF != F or not std::is_same<OU, U>::value) > >
-	constexpr fixed_point_t(const fixed_point_t<OU, OF>& value) :
+	template<typename OU, uint8_t OF, Overflow OO,
+			 typename = std::enable_if_t< (OF != F or not std::is_same<OU, U>::value or OO != O) > >
+	constexpr fixed_point_t(const fixed_point_t<OU, OF, OO>& value) :
 		ival(
 			OF <= F ?
 			// fixed points with lower or equal fractional experience no loss of precision
-			U(value.ival) * (1 << (F - OF)) :
+			(O != Overflow::Wrap ? shifted(value.ival, F - OF) :
+			U(value.ival) * (1 << (F - OF))) :
 			// fixed points with higher fractionals require rounding
-			U( (value.ival + ((value.ival >= 0) ? (1 << (OF - F - 1)) : -(1 << (OF - F - 1)))) / (1 << (OF - F)) )
+			(O != Overflow::Wrap ? narrow((value.ival + ((value.ival >= 0) ? (1 << (OF - F - 1)) : -(1 << (OF - F - 1)))) / (1 << (OF - F))) :
+			U( (value.ival + ((value.ival >= 0) ? (1 << (OF - F - 1)) : -(1 << (OF - F - 1)))) / (1 << (OF - F)) ))
 		) {}
 
 	// assignment operators
@@ -94,9 +162,10 @@ public:
 		return *this = fixed_point_t(rhs);
 	}
 
-	template<typename OU, uint8_t OF, typename = std::enable_if_t< (OF != F or not std::is_same<OU, U>::value) > >
+	template<typename OU, uint8_t OF, Overflow OO,
+			 typename = std::enable_if_t< (OF != F or not std::is_same<OU, U>::value or OO != O) > >
 	constexpr fixed_point_t&
-	operator =(const fixed_point_t<OU, OF>& rhs) {
+	operator =(const fixed_point_t<OU, OF, OO>& rhs) {
 		return *this = fixed_point_t(rhs);
 	}
 
@@ -115,9 +184,9 @@ public:
 	}
 
 	// addition
-	template<typename OU, uint8_t OF>
+	template<typename OU, uint8_t OF, Overflow OO>
 	constexpr fpc_t<OU, OF>
-	operator +(const fixed_point_t<OU, OF>& rhs) const {
+	operator +(const fixed_point_t<OU, OF, OO>& rhs) const {
 		fpc_t<OU, OF> fp(*this);
 		return (fp += fpc_t<OU, OF>(rhs));
 	}
@@ -150,6 +219,13 @@ public:
 	// addition with assignment
 	constexpr fixed_point_t&
 	operator +=(const fixed_point_t& rhs) {
+		if (O != Overflow::Wrap)
+		{
+			// checked in the underlying type, which may be as wide as it gets
+			U sum{};
+			if (__builtin_add_overflow(ival, rhs.ival, &sum)) sum = overflow(rhs.ival < 0);
+			return ival = sum, *this;
+		}
 		return ival += rhs.ival, *this;		// the actual implementation
 	}
 	template< typename ArithmeticType,
@@ -166,9 +242,9 @@ public:
 	}
 
 	// subtraction
-	template<typename OU, uint8_t OF>
+	template<typename OU, uint8_t OF, Overflow OO>
 	constexpr fpc_t<OU, OF>
-	operator -(const fixed_point_t<OU, OF>& rhs) const {
+	operator -(const fixed_point_t<OU, OF, OO>& rhs) const {
 		fpc_t<OU, OF> fp(*this);
 		return (fp -= fpc_t<OU, OF>(rhs));
 	}
@@ -201,6 +277,13 @@ public:
 	// subtraction with assignment
 	constexpr fixed_point_t&
 	operator -=(const fixed_point_t& rhs) {
+		if (O != Overflow::Wrap)
+		{
+			U difference{};
+			if (__builtin_sub_overflow(ival, rhs.ival, &difference))
+				difference = overflow(std::is_unsigned<U>::value or rhs.ival > 0);
+			return ival = difference, *this;
+		}
 		return ival -= rhs.ival, *this;		// the actual implementation
 	}
 	template< typename ArithmeticType,
@@ -217,9 +300,9 @@ public:
 	}
 
 	// multiplication
-	template<typename OU, uint8_t OF>
+	template<typename OU, uint8_t OF, Overflow OO>
 	constexpr fpc_t<OU, OF>
-	operator *(const fixed_point_t<OU, OF>& rhs) const {
+	operator *(const fixed_point_t<OU, OF, OO>& rhs) const {
 		fpc_t<OU, OF> fp(*this);
 		return (fp *= fpc_t<OU, OF>(rhs));
 	}
@@ -252,7 +335,11 @@ public:
 	// multiplcation with assignment
 	constexpr fixed_point_t&
 	operator *=(const fixed_point_t& rhs) {
+		static_assert(O == Overflow::Wrap or sizeof(WideType) > sizeof(U),
+					  "The overflow policy requires a wider type for the product!");
 		WideType m = (WideType(ival) * WideType(rhs.ival));	// the actual implementation
+		if (O != Overflow::Wrap)
+			return ival = narrow((m >= 0) ? (m + half) / one : (m - half) / one), *this;
 		// correct rounding for eps/2
 		if (m > 0) ival = (m + half) / one;
 		else       ival = (m - half) / one;
@@ -272,9 +359,9 @@ public:
 	}
 
 	// division
-	template<typename OU, uint8_t OF>
+	template<typename OU, uint8_t OF, Overflow OO>
 	constexpr fpc_t<OU, OF>
-	operator /(const fixed_point_t<OU, OF>& rhs) const {
+	operator /(const fixed_point_t<OU, OF, OO>& rhs) const {
 		fpc_t<OU, OF> fp(*this);
 		return (fp /= fpc_t<OU, OF>(rhs));
 	}
@@ -308,6 +395,8 @@ public:
 	// division with assignment
 	constexpr fixed_point_t&
 	operator /=(const fixed_point_t& rhs) {
+		static_assert(O == Overflow::Wrap or sizeof(WideType) > sizeof(U),
+					  "The overflow policy requires a wider type for the quotient!");
 		WideType res = (WideType(ival) * one);	// the actual implementation
 		UnderlyingType h = rhs.ival / 2;
 		// correct rounding for eps/2
@@ -315,6 +404,8 @@ public:
 		if (ival < 0) res -= h;
 		else          res += h;
 		// perform the actual division
+		if (O != Overflow::Wrap)
+			return ival = (rhs.ival == 0) ? overflow(ival < 0) : narrow(res / rhs.ival), *this;
 		ival = res / rhs.ival;
 		return *this;
 	}
@@ -347,15 +438,13 @@ public:
 	operator ==(const fixed_point_t& rhs) const {
 		return (ival == rhs.ival);
 	}
-	template< typename IntegralType,
-			  typename = std::enable_if_t< std::is_integral<IntegralType>::value > >
-	constexpr fixed_point_t
+	template< typename IntegralType >
+	constexpr std::enable_if_t< std::is_integral<IntegralType>::value, bool >
 	operator ==(const IntegralType& rhs) const {
 		return (*this == fixed_point_t(rhs));
 	}
-	template< typename FloatingPointType,
-			  typename = std::enable_if_t< std::is_floating_point<FloatingPointType>::value > >
-	constexpr FloatingPointType
+	template< typename FloatingPointType >
+	constexpr std::enable_if_t< std::is_floating_point<FloatingPointType>::value, bool >
 	operator ==(const FloatingPointType& rhs) const {
 		return (FloatingPointType(*this) == rhs);
 	}
@@ -370,15 +459,13 @@ public:
 	operator !=(const fixed_point_t& rhs) const {
 		return (ival != rhs.ival);
 	}
-	template< typename IntegralType,
-			  typename = std::enable_if_t< std::is_integral<IntegralType>::value > >
-	constexpr fixed_point_t
+	template< typename IntegralType >
+	constexpr std::enable_if_t< std::is_integral<IntegralType>::value, bool >
 	operator !=(const IntegralType& rhs) const {
 		return (*this != fixed_point_t(rhs));
 	}
-	template< typename FloatingPointType,
-			  typename = std::enable_if_t< std::is_floating_point<FloatingPointType>::value > >
-	constexpr FloatingPointType
+	template< typename FloatingPointType >
+	constexpr std::enable_if_t< std::is_floating_point<FloatingPointType>::value, bool >
 	operator !=(const FloatingPointType& rhs) const {
 		return (FloatingPointType(*this) != rhs);
 	}
@@ -394,15 +481,13 @@ public:
 	operator <(const fixed_point_t& rhs) const {
 		return (ival < rhs.ival);
 	}
-	template< typename IntegralType,
-			  typename = std::enable_if_t< std::is_integral<IntegralType>::value > >
-	constexpr fixed_point_t
+	template< typename IntegralType >
+	constexpr std::enable_if_t< std::is_integral<IntegralType>::value, bool >
 	operator <(const IntegralType& rhs) const {
 		return (*this < fixed_point_t(rhs));
 	}
-	template< typename FloatingPointType,
-			  typename = std::enable_if_t< std::is_floating_point<FloatingPointType>::value > >
-	constexpr FloatingPointType
+	template< typename FloatingPointType >
+	constexpr std::enable_if_t< std::is_floating_point<FloatingPointType>::value, bool >
 	operator <(const FloatingPointType& rhs) const {
 		return (FloatingPointType(*this) < rhs);
 	}
@@ -418,15 +503,13 @@ public:
 	operator <=(const fixed_point_t& rhs) const {
 		return (ival <= rhs.ival);
 	}
-	template< typename IntegralType,
-			  typename = std::enable_if_t< std::is_integral<IntegralType>::value > >
-	constexpr fixed_point_t
+	template< typename IntegralType >
+	constexpr std::enable_if_t< std::is_integral<IntegralType>::value, bool >
 	operator <=(const IntegralType& rhs) const {
 		return (*this <= fixed_point_t(rhs));
 	}
-	template< typename FloatingPointType,
-			  typename = std::enable_if_t< std::is_floating_point<FloatingPointType>::value > >
-	constexpr FloatingPointType
+	template< typename FloatingPointType >
+	constexpr std::enable_if_t< std::is_floating_point<FloatingPointType>::value, bool >
 	operator <=(const FloatingPointType& rhs) const {
 		return (FloatingPointType(*this) <= rhs);
 	}
@@ -442,15 +525,13 @@ public:
 	operator >(const fixed_point_t& rhs) const {
 		return (ival > rhs.ival);
 	}
-	template< typename IntegralType,
-			  typename = std::enable_if_t< std::is_integral<IntegralType>::value > >
-	constexpr fixed_point_t
+	template< typename IntegralType >
+	constexpr std::enable_if_t< std::is_integral<IntegralType>::value, bool >
 	operator >(const IntegralType& rhs) const {
 		return (*this > fixed_point_t(rhs));
 	}
-	template< typename FloatingPointType,
-			  typename = std::enable_if_t< std::is_floating_point<FloatingPointType>::value > >
-	constexpr FloatingPointType
+	template< typename FloatingPointType >
+	constexpr std::enable_if_t< std::is_floating_point<FloatingPointType>::value, bool >
 	operator >(const FloatingPointType& rhs) const {
 		return (FloatingPointType(*this) > rhs);
 	}
@@ -465,15 +546,13 @@ public:
 	operator >=(const fixed_point_t& rhs) const {
 		return (ival >= rhs.ival);
 	}
-	template< typename IntegralType,
-			  typename = std::enable_if_t< std::is_integral<IntegralType>::value > >
-	constexpr fixed_point_t
+	template< typename IntegralType >
+	constexpr std::enable_if_t< std::is_integral<IntegralType>::value, bool >
 	operator >=(const IntegralType& rhs) const {
 		return (*this >= fixed_point_t(rhs));
 	}
-	template< typename FloatingPointType,
-			  typename = std::enable_if_t< std::is_floating_point<FloatingPointType>::value > >
-	constexpr FloatingPointType
+	template< typename FloatingPointType >
+	constexpr std::enable_if_t< std::is_floating_point<FloatingPointType>::value, bool >
 	operator >=(const FloatingPointType& rhs) const {
 		return (FloatingPointType(*this) >= rhs);
 	}
@@ -487,6 +566,12 @@ public:
 	// negate
 	constexpr fixed_point_t
 	operator -() const {
+		if (O != Overflow::Wrap)
+		{
+			U negated{};
+			if (__builtin_sub_overflow(U(0), ival, &negated)) negated = overflow(std::is_unsigned<U>::value);
+			return fromValue(negated);
+		}
 		return fromValue(-ival);
 	}
 	// posate (wat?)
@@ -514,32 +599,32 @@ template<uint8_t F> using ufix32_t = fixed_point_t<uint32_t, F>;
 namespace xpcc
 {
 	// satisfy xpcc code base with its non-standard type traits.
-	template<typename U, uint8_t F>
-	struct ArithmeticTraits<modm::fixed_point_t<U, F>>
+	template<typename U, uint8_t F, modm::Overflow O>
+	struct ArithmeticTraits<modm::fixed_point_t<U, F, O>>
 	{
-		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::WideType, F> WideType;
-		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::SignedType, F> SignedType;
-		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::UnsignedType, F> UnsignedType;
+		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::WideType, F, O> WideType;
+		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::SignedType, F, O> SignedType;
+		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::UnsignedType, F, O> UnsignedType;
 
 		static constexpr bool isSigned = ArithmeticTraits<U>::isSigned;
 		static constexpr bool isFloatingPoint = true;
 		static constexpr bool isInteger = false;
 
-		static constexpr modm::fixed_point_t<U, F> min = modm::fixed_point_t<U, F>::fromValue(ArithmeticTraits<U>::min);
-		static constexpr modm::fixed_point_t<U, F> max = modm::fixed_point_t<U, F>::fromValue(ArithmeticTraits<U>::max);
+		static constexpr modm::fixed_point_t<U, F, O> min = modm::fixed_point_t<U, F, O>::fromValue(ArithmeticTraits<U>::min);
+		static constexpr modm::fixed_point_t<U, F, O> max = modm::fixed_point_t<U, F, O>::fromValue(ArithmeticTraits<U>::max);
 	};
 
 	// one type traits class wasn't enough for these weirdos.
-	template <typename U, uint8_t F>
-	struct GeometricTraits<modm::fixed_point_t<U, F>>
+	template <typename U, uint8_t F, modm::Overflow O>
+	struct GeometricTraits<modm::fixed_point_t<U, F, O>>
 	{
 		static const bool isValidType = true;
 
-		typedef modm::fixed_point_t<U, F> FloatType;
-		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::WideType, F> WideType;
+		typedef modm::fixed_point_t<U, F, O> FloatType;
+		typedef modm::fixed_point_t<typename ArithmeticTraits<U>::WideType, F, O> WideType;
 
-		static inline modm::fixed_point_t<U, F>
-		round(const modm::fixed_point_t<U, F> &value)
+		static inline modm::fixed_point_t<U, F, O>
+		round(const modm::fixed_point_t<U, F, O> &value)
 		{
 			return ::round(value);
 		}
@@ -547,63 +632,220 @@ namespace xpcc
 
 }	// namespace xpcc
 
-template<typename OU, uint8_t OF>
-constexpr modm::fixed_point_t<OU, OF>
-round(const modm::fixed_point_t<OU, OF>& fp) {
-	typename modm::fixed_point_t<OU, OF>::UnderlyingType v{fp.value()};
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+round(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	typename modm::fixed_point_t<OU, OF, OO>::UnderlyingType v{fp.value()};
 	if (v < 0) {
 		v += (1 << (OF - 1)) - 1;
 	} else {
 		v += (1 << (OF - 1));
 	}
 	v &= ~((1 << OF) - 1);
-	return *reinterpret_cast<modm::fixed_point_t<OU, OF>*>(&v);
+	return *reinterpret_cast<modm::fixed_point_t<OU, OF, OO>*>(&v);
 }
-template<typename OU, uint8_t OF>
-constexpr modm::fixed_point_t<OU, OF>
-floor(const modm::fixed_point_t<OU, OF>& fp) {
-	typename modm::fixed_point_t<OU, OF>::UnderlyingType v{fp.value()};
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+floor(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	typename modm::fixed_point_t<OU, OF, OO>::UnderlyingType v{fp.value()};
 //	if (v < 0) v += 1;
 	v &= ~((1 << OF) - 1);
-	return *reinterpret_cast<modm::fixed_point_t<OU, OF>*>(&v);
+	return *reinterpret_cast<modm::fixed_point_t<OU, OF, OO>*>(&v);
 }
-template<typename OU, uint8_t OF>
-constexpr modm::fixed_point_t<OU, OF>
-ceil(const modm::fixed_point_t<OU, OF>& fp) {
-	typename modm::fixed_point_t<OU, OF>::UnderlyingType v{fp.value()};
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+ceil(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	typename modm::fixed_point_t<OU, OF, OO>::UnderlyingType v{fp.value()};
 	if (v >= 0) {
 		v += (1 << OF) - 1;
 	} else {
 		v += (1 << OF);
 	}
 	v &= ~((1 << OF) - 1);
-	return *reinterpret_cast<modm::fixed_point_t<OU, OF>*>(&v);
+	return *reinterpret_cast<modm::fixed_point_t<OU, OF, OO>*>(&v);
 }
-template<typename OU, uint8_t OF>
-constexpr modm::fixed_point_t<OU, OF>
-trunc(const modm::fixed_point_t<OU, OF>& fp) {
-	typename modm::fixed_point_t<OU, OF>::UnderlyingType v{fp.value()};
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+trunc(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	typename modm::fixed_point_t<OU, OF, OO>::UnderlyingType v{fp.value()};
 	v &= ~((1 << OF) - 1);
 	if (v < 0) v += (1 << OF);
-	return *reinterpret_cast<modm::fixed_point_t<OU, OF>*>(&v);
+	return *reinterpret_cast<modm::fixed_point_t<OU, OF, OO>*>(&v);
 }
 
-template<typename OU, uint8_t OF>
-constexpr modm::fixed_point_t<OU, OF>
-abs(const modm::fixed_point_t<OU, OF>& fp) {
-	modm::fixed_point_t<OU, OF> v{fp};
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+abs(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	modm::fixed_point_t<OU, OF, OO> v{fp};
 	if (v < 0) v = -v;
 	return v;
 }
 
 // this is non-standard... I think...
-template<typename OU, uint8_t OF>
-constexpr modm::fixed_point_t<OU, OF>
-signbit(const modm::fixed_point_t<OU, OF>& fp) {
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+signbit(const modm::fixed_point_t<OU, OF, OO>& fp) {
 	if (fp < 0) {
 		return -(1 << OF);
 	}
 	return (1 << OF);
 }
 
+namespace modm
+{
+
+namespace detail
+{
+	// rounded integer square root, digit by digit
+	template<typename T>
+	constexpr T
+	isqrt(T v) {
+		T root{0};
+		T bit = T(1) << (sizeof(T) * 8 - 2);
+		while (bit > v) bit >>= 2;
+		while (bit) {
+			if (v >= root + bit) {
+				v -= root + bit;
+				root = (root >> 1) + bit;
+			}
+			else root >>= 1;
+			bit >>= 2;
+		}
+		// v is now the remainder, round up if v > root
+		if (v > root) root++;
+		return root;
+	}
+
+	// converts a value with Q fractional bits to F fractional bits with rounding
+	template<uint8_t F>
+	constexpr int64_t
+	requantize(const int64_t v, const uint8_t Q) {
+		if (Q > F) return (v + (int64_t(1) << (Q - F - 1))) >> (Q - F);
+		return v * (int64_t(1) << (F - Q));
+	}
+
+	// CORDIC with angles in Q29 radians and vectors in Q30.
+	// The template parameter only allows defining the table in this header.
+	template<typename T = void>
+	struct Cordic
+	{
+		static constexpr uint8_t MaxIterations = 30;
+		static constexpr int32_t angles[MaxIterations] = {
+			421657428, 248918915, 131521918, 66762579, 33510843, 16771758, 8387925, 4194219,
+			2097141, 1048575, 524288, 262144, 131072, 65536, 32768, 16384,
+			8192, 4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1 };
+		static constexpr int32_t Gain = 652032874;	// 1/1.6467602 in Q30
+		static constexpr int32_t Pi = 1686629713;
+		static constexpr int64_t Tau = 3373259426;
+
+		struct Vector { int32_t x; int32_t y; };
+
+		// four guard iterations keep the error of the result below one eps
+		static constexpr uint8_t
+		iterations(uint8_t F) {
+			return (F + 4 < MaxIterations) ? F + 4 : MaxIterations;
+		}
+
+		// returns (cos, sin) of the angle in Q F radians
+		template<uint8_t F>
+		static constexpr Vector
+		rotate(int64_t angle) {
+			// reduce to [-pi, pi], then to [-pi/2, pi/2]
+			angle = requantize<29>(angle, F) % Tau;
+			if (angle >  Pi) angle -= Tau;
+			if (angle < -Pi) angle += Tau;
+			bool mirror = false;
+			if (angle >  Pi/2) { angle =  Pi - angle; mirror = true; }
+			if (angle < -Pi/2) { angle = -Pi - angle; mirror = true; }
+
+			int32_t x{Gain}, y{0}, z = int32_t(angle);
+			for (uint8_t ii = 0; ii < iterations(F); ii++) {
+				const int32_t dx = y >> ii, dy = x >> ii;
+				if (z >= 0) { x -= dx; y += dy; z -= angles[ii]; }
+				else        { x += dx; y -= dy; z += angles[ii]; }
+			}
+			return {mirror ? -x : x, y};
+		}
+
+		// returns the angle of (x, y) in Q29 radians
+		static constexpr int64_t
+		angle(int64_t x, int64_t y) {
+			if (x == 0 and y == 0) return 0;
+			// scale the larger magnitude to [2^28, 2^29) to avoid overflow
+			int64_t m = (x < 0 ? -x : x) | (y < 0 ? -y : y);
+			while (m >= (int64_t(1) << 29)) { m >>= 1; x >>= 1; y >>= 1; }
+			while (m <  (int64_t(1) << 28)) { m <<= 1; x <<= 1; y <<= 1; }
+			// rotate the left half plane by pi into the right one
+			int64_t offset{0};
+			if (x < 0) { offset = (y >= 0) ? Pi : -Pi; x = -x; y = -y; }
+
+			int32_t vx = int32_t(x), vy = int32_t(y), z{0};
+			for (uint8_t ii = 0; ii < MaxIterations - 1; ii++) {
+				const int32_t dx = vy >> ii, dy = vx >> ii;
+				if (vy > 0) { vx += dx; vy -= dy; z += angles[ii]; }
+				else        { vx -= dx; vy += dy; z -= angles[ii]; }
+			}
+			return offset + z;
+		}
+	};
+	template<typename T>
+	constexpr int32_t Cordic<T>::angles[];
+
+}	// namespace detail
+
+}	// namespace modm
+
+// returns zero for negative values
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+sqrt(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	using Unsigned = typename xpcc::ArithmeticTraits<typename xpcc::ArithmeticTraits<OU>::WideType>::UnsignedType;
+	if (fp.value() <= 0) return modm::fixed_point_t<OU, OF, OO>();
+	return modm::fixed_point_t<OU, OF, OO>::fromValue(OU(modm::detail::isqrt(Unsigned(fp.value()) << OF)));
+}
+
+// 1/x without a division of fixed points, x must not be zero
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+reciprocal(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	using WideType = typename xpcc::ArithmeticTraits<OU>::WideType;
+	const WideType v = fp.value();
+	const WideType one = WideType(1) << (2 * OF);
+	return modm::fixed_point_t<OU, OF, OO>::fromValue(OU((one + (v < 0 ? -v : v) / 2) / v));
+}
+
+// 1/sqrt(x), x must be positive
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+rsqrt(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	using Unsigned = typename xpcc::ArithmeticTraits<typename xpcc::ArithmeticTraits<OU>::WideType>::UnsignedType;
+	// sqrt(2^3F / x) is exact if 2^3F fits into the wide type
+	constexpr uint8_t shift = (3 * OF < sizeof(Unsigned) * 8) ? 3 * OF : 0;
+	if (shift == 0) return reciprocal(sqrt(fp));
+	const Unsigned v = fp.value();
+	return modm::fixed_point_t<OU, OF, OO>::fromValue(OU(modm::detail::isqrt(((Unsigned(1) << shift) + v / 2) / v)));
+}
+
+// the angle is in radians, the result has the same precision
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+sin(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	return modm::fixed_point_t<OU, OF, OO>::fromValue(OU(modm::detail::requantize<OF>(
+			modm::detail::Cordic<>::rotate<OF>(fp.value()).y, 30)));
+}
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+cos(const modm::fixed_point_t<OU, OF, OO>& fp) {
+	return modm::fixed_point_t<OU, OF, OO>::fromValue(OU(modm::detail::requantize<OF>(
+			modm::detail::Cordic<>::rotate<OF>(fp.value()).x, 30)));
+}
+
+// returns the angle in radians within [-pi, pi]
+template<typename OU, uint8_t OF, modm::Overflow OO>
+constexpr modm::fixed_point_t<OU, OF, OO>
+atan2(const modm::fixed_point_t<OU, OF, OO>& y, const modm::fixed_point_t<OU, OF, OO>& x) {
+	return modm::fixed_point_t<OU, OF, OO>::fromValue(OU(modm::detail::requantize<OF>(
+			modm::detail::Cordic<>::angle(x.value(), y.value()), 29)));
+}
+
 #endif // MODM_FIXED_POINT_HPP
@@ -0,0 +1,211 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_FIXED_POINT_ARRAY_HPP
+#define MODM_FIXED_POINT_ARRAY_HPP
+
+#include <cstddef>
+#include "fixed_point.hpp"
+
+namespace modm
+{
+
+// Operations on contiguous arrays of fixed points, which give the same results
+// as the scalar operators, including their rounding and overflow policy.
+// The loops are kept branch-free, so that they are vectorized on hosted builds
+// and unrolled on targets. Output arrays must not overlap with the inputs,
+// except for being identical to one of them.
+namespace fixed_point_array
+{
+
+namespace detail
+{
+	template< typename Function >
+	inline void
+	forEach(const std::size_t size, Function &&function)
+	{
+#ifdef XPCC__OS_HOSTED
+		// leave it to the auto-vectorizer
+		for (std::size_t ii = 0; ii < size; ii++) function(ii);
+#else
+		std::size_t ii = 0;
+		for (; ii + 4 <= size; ii += 4)
+		{
+			function(ii);
+			function(ii + 1);
+			function(ii + 2);
+			function(ii + 3);
+		}
+		for (; ii < size; ii++) function(ii);
+#endif
+	}
+
+	// a * b with the rounding of `operator *=`
+	template< typename U, uint8_t F >
+	inline U
+	multiply(const U a, const U b)
+	{
+		using WideType = typename xpcc::ArithmeticTraits<U>::WideType;
+		constexpr WideType one = WideType(1) << F;
+		constexpr WideType half = WideType(1) << (F - 1);
+
+		const WideType m = WideType(a) * WideType(b);
+		return U((m + (m > 0 ? half : -half)) / one);
+	}
+}
+
+// out = a + b
+template< typename U, uint8_t F, Overflow O >
+void
+add(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> *b, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = a[ii] + b[ii];
+		else out[ii] = T::fromValue(a[ii].value() + b[ii].value());
+	});
+}
+
+// out = a + b
+template< typename U, uint8_t F, Overflow O >
+void
+add(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> b, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = a[ii] + b;
+		else out[ii] = T::fromValue(a[ii].value() + b.value());
+	});
+}
+
+// out = a * b
+template< typename U, uint8_t F, Overflow O >
+void
+multiply(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> *b, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = a[ii] * b[ii];
+		else out[ii] = T::fromValue(detail::multiply<U, F>(a[ii].value(), b[ii].value()));
+	});
+}
+
+// out = a * b
+template< typename U, uint8_t F, Overflow O >
+void
+multiply(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> b, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = a[ii] * b;
+		else out[ii] = T::fromValue(detail::multiply<U, F>(a[ii].value(), b.value()));
+	});
+}
+
+// out += a * b
+template< typename U, uint8_t F, Overflow O >
+void
+multiplyAccumulate(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> *b, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] += a[ii] * b[ii];
+		else out[ii] = T::fromValue(out[ii].value() + detail::multiply<U, F>(a[ii].value(), b[ii].value()));
+	});
+}
+
+// out = a * b + c, for example to scale and offset coordinates
+template< typename U, uint8_t F, Overflow O >
+void
+multiplyAccumulate(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> b, const fixed_point_t<U, F, O> c,
+				   fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = a[ii] * b + c;
+		else out[ii] = T::fromValue(detail::multiply<U, F>(a[ii].value(), b.value()) + c.value());
+	});
+}
+
+// out = a + (b - a) * t
+template< typename U, uint8_t F, Overflow O >
+void
+lerp(const fixed_point_t<U, F, O> *a, const fixed_point_t<U, F, O> *b, const fixed_point_t<U, F, O> t,
+	 fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = a[ii] + (b[ii] - a[ii]) * t;
+		else
+		{
+			const U difference = b[ii].value() - a[ii].value();
+			out[ii] = T::fromValue(a[ii].value() + detail::multiply<U, F>(difference, t.value()));
+		}
+	});
+}
+
+
+// with the rounding of the constructor
+template< typename U, uint8_t F, Overflow O >
+void
+convert(const float *in, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	constexpr float halfeps{1.f/(1 << (F+1))};
+	constexpr U one{1 << F};
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		const float value = in[ii];
+		if (O != Overflow::Wrap) out[ii] = T(value);
+		else out[ii] = T::fromValue(U((value + ((value >= 0) ? halfeps : -halfeps)) * one));
+	});
+}
+
+template< typename U, uint8_t F, Overflow O >
+void
+convert(const fixed_point_t<U, F, O> *in, float *out, std::size_t size)
+{
+	constexpr U one{1 << F};
+	detail::forEach(size, [=](std::size_t ii)
+	{ out[ii] = float(in[ii].value()) / one; });
+}
+
+template< typename U, uint8_t F, Overflow O >
+void
+convert(const int16_t *in, fixed_point_t<U, F, O> *out, std::size_t size)
+{
+	using T = fixed_point_t<U, F, O>;
+	constexpr U one{1 << F};
+	detail::forEach(size, [=](std::size_t ii)
+	{
+		if (O != Overflow::Wrap) out[ii] = T(in[ii]);
+		else out[ii] = T::fromValue(in[ii] * one);
+	});
+}
+
+// truncated towards zero like the cast
+template< typename U, uint8_t F, Overflow O >
+void
+convert(const fixed_point_t<U, F, O> *in, int16_t *out, std::size_t size)
+{
+	constexpr U one{1 << F};
+	detail::forEach(size, [=](std::size_t ii)
+	{ out[ii] = int16_t(in[ii].value() / one); });
+}
+
+}	// namespace fixed_point_array
+
+}	// namespace modm
+
+#endif // MODM_FIXED_POINT_ARRAY_HPP
@@ -1393,6 +1393,36 @@ FixedPointTest::testDivisionEpsRounding()
 	TEST_ASSERT_EQUALS(-13, ut(fp));
 }
 
+void
+FixedPointTest::testComparison()
+{
+	// comparisons with integral and floating point values are plain bools
+	static_assert(std::is_same<decltype(fix16_t<4>{} == 0), bool>::value, "");
+	static_assert(std::is_same<decltype(fix16_t<4>{} != 0), bool>::value, "");
+	static_assert(std::is_same<decltype(fix16_t<4>{} < 0), bool>::value, "");
+	static_assert(std::is_same<decltype(fix16_t<4>{} <= 0), bool>::value, "");
+	static_assert(std::is_same<decltype(fix16_t<4>{} > 0.f), bool>::value, "");
+	static_assert(std::is_same<decltype(fix16_t<4>{} >= 0.f), bool>::value, "");
+
+	const fix16_t<4> fpp{2.5f};
+	const fix16_t<4> fpn{-1.75f};
+
+	TEST_ASSERT_TRUE(fpp == 2.5f);
+	TEST_ASSERT_TRUE(fpp != 2);
+	TEST_ASSERT_TRUE(fpn < 0);
+	TEST_ASSERT_TRUE(fpn <= -1.75);
+	TEST_ASSERT_TRUE(fpp > 2);
+	TEST_ASSERT_TRUE(fpp >= 2.5);
+	TEST_ASSERT_FALSE(fpp <= 2);
+	TEST_ASSERT_FALSE(fpn > -1);
+	TEST_ASSERT_TRUE(3 > fpp);
+	TEST_ASSERT_TRUE(-2 < fpn);
+	TEST_ASSERT_FALSE(0 == fpn);
+
+	// the result is usable as a count
+	TEST_ASSERT_EQUALS((fpp > 0) + (fpn > 0) + (fpp > 2), 2);
+}
+
 void
 FixedPointTest::testShifting()
 {
@@ -1523,3 +1553,269 @@ FixedPointTest::testCMath()
 		TEST_ASSERT_EQUALS(-80, ut(trunc(fp)));	// -5.0
 	}
 }
+
+void
+FixedPointTest::testSquareRoot()
+{
+	TEST_ASSERT_EQUALS(0, ut(sqrt(fix16_t<4>{0})));
+	TEST_ASSERT_EQUALS(0, ut(sqrt(fix16_t<4>{-4})));
+	TEST_ASSERT_EQUALS(32, ut(sqrt(fix16_t<4>{4})));				// 2.0
+	TEST_ASSERT_EQUALS(8, ut(sqrt(fix16_t<4>{0.25f})));			// 0.5
+	TEST_ASSERT_EQUALS(23, ut(sqrt(fix16_t<4>{2})));				// 1.4375
+	TEST_ASSERT_EQUALS(92682, ut(sqrt(fix32_t<16>{2})));			// 1.41421
+	TEST_ASSERT_EQUALS(181 << 16, ut(sqrt(fix32_t<16>{32761})));	// 181.0
+
+	// the result is rounded to the nearest eps
+	for (int32_t v = 1; v < (1 << 20); v += 997)
+	{
+		const fix32_t<16> fp = fix32_t<16>::fromValue(v);
+		TEST_ASSERT_EQUALS_DELTA(ut(sqrt(fp)), std::sqrt(v * 65536.0), 0.5);
+	}
+	for (int16_t v = 1; v < INT16_MAX - 100; v += 101)
+	{
+		const fix16_t<8> fp = fix16_t<8>::fromValue(v);
+		TEST_ASSERT_EQUALS_DELTA(ut(sqrt(fp)), std::sqrt(v * 256.0), 0.5);
+	}
+
+	TEST_ASSERT_EQUALS(16, ut(rsqrt(fix16_t<4>{1})));				// 1.0
+	TEST_ASSERT_EQUALS(8, ut(rsqrt(fix16_t<4>{4})));				// 0.5
+	TEST_ASSERT_EQUALS(46341, ut(rsqrt(fix32_t<16>{2})));			// 0.70711
+	for (int32_t v = 1; v < (1 << 24); v += 9973)
+	{
+		const fix32_t<16> fp = fix32_t<16>::fromValue(v);
+		TEST_ASSERT_EQUALS_DELTA(ut(rsqrt(fp)), 65536.0 / std::sqrt(v / 65536.0), 1);
+	}
+}
+
+void
+FixedPointTest::testReciprocal()
+{
+	TEST_ASSERT_EQUALS(16, ut(reciprocal(fix16_t<4>{1})));		// 1.0
+	TEST_ASSERT_EQUALS(-8, ut(reciprocal(fix16_t<4>{-2})));		// -0.5
+	TEST_ASSERT_EQUALS(64, ut(reciprocal(fix16_t<4>{0.25f})));	// 4.0
+	TEST_ASSERT_EQUALS(5, ut(reciprocal(fix16_t<4>{3})));			// 0.3125
+	TEST_ASSERT_EQUALS(-21845, ut(reciprocal(fix32_t<16>{-3})));	// -0.33333
+
+	for (int32_t v = 3; v < (1 << 24); v += 9973)
+	{
+		const fix32_t<16> fp = fix32_t<16>::fromValue(v);
+		TEST_ASSERT_EQUALS_DELTA(ut(reciprocal(fp)), 65536.0 * 65536.0 / v, 0.5);
+		TEST_ASSERT_EQUALS_DELTA(ut(reciprocal(-fp)), -65536.0 * 65536.0 / v, 0.5);
+	}
+}
+
+void
+FixedPointTest::testTrigonometry()
+{
+	constexpr double pi = 3.14159265358979323846;
+
+	TEST_ASSERT_EQUALS(0, ut(sin(fix32_t<16>{0})));
+	TEST_ASSERT_EQUALS(65536, ut(cos(fix32_t<16>{0})));
+	TEST_ASSERT_EQUALS(16, ut(sin(fix16_t<4>{pi / 2})));
+	TEST_ASSERT_EQUALS(-16, ut(cos(fix16_t<4>{pi})));
+	TEST_ASSERT_EQUALS(0, ut(atan2(fix32_t<16>{0}, fix32_t<16>{0})));
+	TEST_ASSERT_EQUALS(0, ut(atan2(fix32_t<16>{0}, fix32_t<16>{5})));
+	TEST_ASSERT_EQUALS(ut(fix32_t<16>{pi / 2}), ut(atan2(fix32_t<16>{3}, fix32_t<16>{0})));
+	TEST_ASSERT_EQUALS(ut(fix32_t<16>{-pi / 2}), ut(atan2(fix32_t<16>{-3}, fix32_t<16>{0})));
+	TEST_ASSERT_EQUALS(ut(fix32_t<16>{pi}), ut(atan2(fix32_t<16>{0}, fix32_t<16>{-1})));
+
+	// the error is below one eps within the whole range
+	for (int32_t v = -(100 << 16); v < (100 << 16); v += 997)
+	{
+		const fix32_t<16> fp = fix32_t<16>::fromValue(v);
+		TEST_ASSERT_EQUALS_DELTA(ut(sin(fp)), std::sin(v / 65536.0) * 65536, 1);
+		TEST_ASSERT_EQUALS_DELTA(ut(cos(fp)), std::cos(v / 65536.0) * 65536, 1);
+	}
+	for (int16_t v = -2000; v < 2000; v++)
+	{
+		const fix16_t<4> fp = fix16_t<4>::fromValue(v);
+		TEST_ASSERT_EQUALS_DELTA(ut(sin(fp)), std::sin(v / 16.0) * 16, 1);
+		TEST_ASSERT_EQUALS_DELTA(ut(cos(fp)), std::cos(v / 16.0) * 16, 1);
+	}
+	const double radii[] = {0.01, 1.0, 1000.0};
+	for (int16_t angle = -180; angle < 180; angle++)
+	{
+		const double radians = angle * pi / 180;
+		for (const double radius : radii)
+		{
+			const fix32_t<16> x{std::cos(radians) * radius}, y{std::sin(radians) * radius};
+			TEST_ASSERT_EQUALS_DELTA(ut(atan2(y, x)), std::atan2(double(ut(y)), double(ut(x))) * 65536, 1);
+		}
+	}
+
+	// usable in constant expressions
+	constexpr fix32_t<16> s = sin(fix32_t<16>{pi / 6});
+	TEST_ASSERT_EQUALS(32768, ut(s));	// 0.5
+}
+
+void
+FixedPointTest::testArrayArithmetic()
+{
+	namespace fpa = modm::fixed_point_array;
+	constexpr std::size_t size = 103;	// not a multiple of the unrolling
+	fix32_t<16> a[size], b[size], out[size];
+	fix16_t<4> c[size], d[size], out16[size];
+
+	// values with all kinds of signs and rounding cases
+	uint32_t seed = 42;
+	for (std::size_t ii = 0; ii < size; ii++)
+	{
+		seed = seed * 1103515245 + 12345;
+		a[ii] = fix32_t<16>::fromValue(int32_t(seed) >> 9);
+		seed = seed * 1103515245 + 12345;
+		b[ii] = fix32_t<16>::fromValue(int32_t(seed) >> 11);
+		c[ii] = fix16_t<4>::fromValue(int16_t(seed >> 16) >> 4);
+		d[ii] = fix16_t<4>::fromValue(int16_t(seed) >> 6);
+	}
+	const fix32_t<16> t{0.3f}, offset{-12.5f};
+
+	fpa::add(a, b, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] + b[ii]), ut(out[ii]));
+	fpa::add(a, offset, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] + offset), ut(out[ii]));
+
+	fpa::multiply(a, b, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] * b[ii]), ut(out[ii]));
+	fpa::multiply(a, t, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] * t), ut(out[ii]));
+	fpa::multiply(c, d, out16, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(c[ii] * d[ii]), ut(out16[ii]));
+
+	for (std::size_t ii = 0; ii < size; ii++) out[ii] = offset;
+	fpa::multiplyAccumulate(a, b, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(offset + a[ii] * b[ii]), ut(out[ii]));
+	fpa::multiplyAccumulate(a, t, offset, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] * t + offset), ut(out[ii]));
+
+	fpa::lerp(a, b, t, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] + (b[ii] - a[ii]) * t), ut(out[ii]));
+	fpa::lerp(c, d, fix16_t<4>{0.75f}, out16, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(c[ii] + (d[ii] - c[ii]) * fix16_t<4>{0.75f}), ut(out16[ii]));
+
+	// in place
+	for (std::size_t ii = 0; ii < size; ii++) out[ii] = a[ii];
+	fpa::multiply(out, t, out, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(a[ii] * t), ut(out[ii]));
+}
+
+void
+FixedPointTest::testArrayConversion()
+{
+	namespace fpa = modm::fixed_point_array;
+	constexpr std::size_t size = 21;
+	const float floats[size] = {0.f, 1.f, -1.f, 0.5f, -0.5f, 0.03125f, -0.03125f, 0.03124f, -0.03126f,
+								3.14159f, -2.71828f, 100.99f, -100.99f, 0.015625f, -0.015625f,
+								1000.f, -1000.f, 0.0001f, -0.0001f, 7.96875f, -7.96875f};
+	fix16_t<4> fp[size];
+	float back[size];
+
+	fpa::convert(floats, fp, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(fix16_t<4>{floats[ii]}), ut(fp[ii]));
+	fpa::convert(fp, back, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_TRUE(float(fp[ii]) == back[ii]);
+
+	int16_t integers[size], truncated[size];
+	for (std::size_t ii = 0; ii < size; ii++) integers[ii] = int16_t(ii * 397) - 4000;
+	fix32_t<16> fp32[size];
+	fpa::convert(integers, fp32, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(fix32_t<16>{integers[ii]}), ut(fp32[ii]));
+
+	fpa::convert(floats, fp32, size);
+	fpa::convert(fp32, truncated, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(int16_t(fp32[ii]), truncated[ii]);
+}
+
+void
+FixedPointTest::testSaturation()
+{
+	using sfix16_t = modm::fixed_point_t<int16_t, 4, modm::Overflow::Saturate>;
+	using sufix16_t = modm::fixed_point_t<uint16_t, 4, modm::Overflow::Saturate>;
+
+	// construction
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(sfix16_t{3000}));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(sfix16_t{-3000}));
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(sfix16_t{2048.f}));
+	TEST_ASSERT_EQUALS(32752, ut(sfix16_t{2047}));
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(sfix16_t{2047.96875f}));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(sfix16_t{-2048.01f}));
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(sfix16_t{fix32_t<16>{5000}}));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(sfix16_t{fix32_t<8>{-5000}}));
+	TEST_ASSERT_EQUALS(0, ut(sufix16_t{-1}));
+	TEST_ASSERT_EQUALS(0, ut(sufix16_t{fix16_t<4>{-1}}));
+
+	// addition and subtraction
+	sfix16_t a{2000}, b{100};
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(a + b));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(-a - b - b));
+	TEST_ASSERT_EQUALS(1900 * 16, ut(a - b));
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(-sfix16_t::fromValue(INT16_MIN)));
+	TEST_ASSERT_EQUALS(0, ut(sufix16_t{1} - sufix16_t{2}));
+	TEST_ASSERT_EQUALS(UINT16_MAX, ut(sufix16_t{4000} + sufix16_t{100}));
+	TEST_ASSERT_EQUALS(0, ut(-sufix16_t{1}));
+
+	// the underlying type is the widest one, so no wider type can hold the result
+	using sfix64_t = modm::fixed_point_t<int64_t, 16, modm::Overflow::Saturate>;
+	using sufix64_t = modm::fixed_point_t<uint64_t, 16, modm::Overflow::Saturate>;
+	const sfix64_t big = sfix64_t::fromValue(INT64_MAX - 5), small = sfix64_t::fromValue(INT64_MIN + 5);
+	TEST_ASSERT_TRUE(ut(big + sfix64_t{1}) == INT64_MAX);
+	TEST_ASSERT_TRUE(ut(small - sfix64_t{1}) == INT64_MIN);
+	TEST_ASSERT_TRUE(ut(small + sfix64_t{-1}) == INT64_MIN);
+	TEST_ASSERT_TRUE(ut(big - sfix64_t{-1}) == INT64_MAX);
+	TEST_ASSERT_TRUE(ut(-sfix64_t::fromValue(INT64_MIN)) == INT64_MAX);
+	TEST_ASSERT_TRUE(ut(big - sfix64_t::fromValue(5)) == INT64_MAX - 10);
+	TEST_ASSERT_TRUE(ut(sufix64_t{1} - sufix64_t{2}) == 0u);
+	TEST_ASSERT_TRUE(ut(sufix64_t::fromValue(UINT64_MAX - 1) + sufix64_t{1}) == UINT64_MAX);
+
+	// multiplication and division
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(a * b));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(a * -b));
+	TEST_ASSERT_EQUALS(20 * 16, ut(a / b));
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(a / sfix16_t{0.0625f}));
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(a / sfix16_t{0}));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(-a / sfix16_t{0}));
+	TEST_ASSERT_EQUALS(0, ut(sufix16_t{0} * sufix16_t{3}));
+
+	// results within range are identical to wrapping
+	for (int16_t v = -2000; v < 2000; v += 7)
+	{
+		const fix16_t<4> x = fix16_t<4>::fromValue(v), y{-1.375f};
+		const sfix16_t sx = sfix16_t::fromValue(v), sy{-1.375f};
+		TEST_ASSERT_EQUALS(ut(x + y), ut(sx + sy));
+		TEST_ASSERT_EQUALS(ut(x - y), ut(sx - sy));
+		TEST_ASSERT_EQUALS(ut(x * y), ut(sx * sy));
+		TEST_ASSERT_EQUALS(ut(x / y), ut(sx / sy));
+		TEST_ASSERT_EQUALS(ut(-x), ut(-sx));
+	}
+
+	// the wrapping default is unchanged
+	TEST_ASSERT_EQUALS(-31936, ut(fix16_t<4>{2000} + fix16_t<4>{100}));
+
+	// array operations apply the policy like the scalar operators
+	namespace fpa = modm::fixed_point_array;
+	constexpr std::size_t size = 11;
+	sfix16_t sa[size], sb[size], sout[size];
+	for (std::size_t ii = 0; ii < size; ii++)
+	{
+		sa[ii] = sfix16_t{int16_t(ii * 400 - 2000)};
+		sb[ii] = sfix16_t{int16_t(1900 - ii * 350)};
+	}
+	const sfix16_t st{1.5f};
+
+	fpa::add(sa, sb, sout, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(sa[ii] + sb[ii]), ut(sout[ii]));
+	fpa::add(sa, b, sout, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(sa[ii] + b), ut(sout[ii]));
+	fpa::multiply(sa, sb, sout, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(sa[ii] * sb[ii]), ut(sout[ii]));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(sout[0]));
+	fpa::multiplyAccumulate(sa, st, b, sout, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(sa[ii] * st + b), ut(sout[ii]));
+	fpa::lerp(sa, sb, st, sout, size);
+	for (std::size_t ii = 0; ii < size; ii++) TEST_ASSERT_EQUALS(ut(sa[ii] + (sb[ii] - sa[ii]) * st), ut(sout[ii]));
+
+	const float floats[3] = {5000.f, -5000.f, 1.5f};
+	fpa::convert(floats, sout, 3);
+	TEST_ASSERT_EQUALS(INT16_MAX, ut(sout[0]));
+	TEST_ASSERT_EQUALS(INT16_MIN, ut(sout[1]));
+	TEST_ASSERT_EQUALS(24, ut(sout[2]));
+}
@@ -7,11 +7,12 @@
 
 #include <unittest/testsuite.hpp>
 #include "../fixed_point.hpp"
+#include "../fixed_point_array.hpp"
 
 class FixedPointTest : public unittest::TestSuite
 {
-	template<typename U, uint8_t F>
-	U ut(const modm::fixed_point_t<U, F>& fp) {
+	template<typename U, uint8_t F, modm::Overflow O>
+	U ut(const modm::fixed_point_t<U, F, O>& fp) {
 		return fp.value();
 	}
 public:
@@ -48,9 +49,30 @@ public:
 	void
 	testDivisionEpsRounding();
 
+	void
+	testComparison();
+
 	void
 	testShifting();
 
 	void
 	testCMath();
+
+	void
+	testSquareRoot();
+
+	void
+	testReciprocal();
+
+	void
+	testTrigonometry();
+
+	void
+	testArrayArithmetic();
+
+	void
+	testArrayConversion();
+
+	void
+	testSaturation();
 };
@@ -10,13 +10,20 @@
 
 #include "surface.hpp"
 #include "color.hpp"
+#include "painter_statistics.hpp"
+#include "trace.hpp"
 #include <xpcc/ui/animation/interpolation.hpp>
 #include <xpcc/math/utils/misc.hpp>
 
 #include "geometry/point.hpp"
 #include "geometry/line.hpp"
 #include "geometry/rect.hpp"
+#include "geometry/rounded_rect.hpp"
 #include "geometry/circle.hpp"
+#include "geometry/angle_range.hpp"
+#include "geometry/region.hpp"
+#include "geometry/transform.hpp"
+#include "image/rle_image.hpp"
 
 namespace modm
 {
@@ -24,6 +31,13 @@ namespace modm
 namespace ges
 {
 
+enum class
+Sampling : uint8_t
+{
+	Nearest,
+	Bilinear,
+};
+
 template< PixelFormat Format >
 class Painter
 {
@@ -64,10 +78,67 @@ public:
 	void
 	resetClipArea();
 
+	// the region is not copied and must stay valid until the clip area is reset
+	void
+	setClipRegion(const Region &region);
+
+#ifdef MODM_GES_STATISTICS
+	// Collects the counters of every primitive into the statistics, which must stay valid.
+	// The clock returns a free running time in any unit, for example microseconds.
+	inline void
+	setStatistics(PainterStatistics *statistics, uint32_t (*clock)() = nullptr)
+	{ this->statistics = statistics; this->clock = clock; }
+#endif
+
+#ifdef MODM_GES_TRACE
+	// Records every outermost primitive as an event into the trace, which must stay valid.
+	inline void
+	setTrace(Trace *trace)
+	{ this->trace = trace; }
+
+	inline Trace *
+	getTrace() const
+	{ return trace; }
+#endif
+
+#ifdef MODM_GES_DAMAGE
+	// Records the bounds of every primitive within the clip area into the region,
+	// which must stay valid. Too complex damage is simplified to its bounding rectangle.
+	inline void
+	setDamage(Region *damage)
+	{ this->damage = damage; }
+
+	inline Region *
+	getDamage() const
+	{ return damage; }
+#endif
+
+	inline NativeSurface &
+	getSurface() const
+	{ return surface; }
+
+#ifdef MODM_GES_DEBUG_OVERDRAW
+	// Counts the writes of every pixel by spans into one counter per pixel,
+	// in rows of the surface width. Filled primitives write every pixel once.
+	inline void
+	setWriteCounters(uint8_t *counters)
+	{ writeCounters = counters; }
+#endif
+
+
+	void
+	drawPoints(const Point *points, std::size_t count, const AlphaColor color, const CompositionOperator composition = A);
+
+	void
+	drawPoints(const Point *points, const AlphaColor *colors, std::size_t count, const CompositionOperator composition = A);
+
 
 	void
 	drawLine(const Line &line, const AlphaColor color, CompositionOperator composition = A);
 
+	void
+	drawPolyline(const Point *points, std::size_t count, const AlphaColor color, const CompositionOperator composition = A);
+
 
 	void
 	drawRect(const Rect &rectangle, const AlphaColor color, const CompositionOperator composition = A);
@@ -77,6 +148,13 @@ public:
 	fillRect(const Rect &rectangle, const AlphaColor color, const CompositionOperator composition = A);
 
 
+	void
+	drawRoundedRect(const RoundedRect &rectangle, const AlphaColor color, const CompositionOperator composition = A);
+
+	void
+	fillRoundedRect(const RoundedRect &rectangle, const AlphaColor color, const CompositionOperator composition = A);
+
+
 	void
 	drawCircle(const Circle &circle, const AlphaColor color, const CompositionOperator composition = A);
 
@@ -84,6 +162,20 @@ public:
 	void
 	fillCircle(const Circle &circle, const AlphaColor color, const CompositionOperator composition = A);
 
+	// the part of the circle from the start clockwise to the end angle
+	void
+	drawArc(const Circle &circle, const angle_t start, const angle_t end,
+			const AlphaColor color, const CompositionOperator composition = A);
+
+	void
+	fillPie(const Circle &circle, const angle_t start, const angle_t end,
+			const AlphaColor color, const CompositionOperator composition = A);
+
+	// fills the radii from the inner radius up to the radius of the circle
+	void
+	fillRing(const Circle &circle, const int16_t innerRadius, const angle_t start, const angle_t end,
+			 const AlphaColor color, const CompositionOperator composition = A);
+
 	void
 	drawEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition = A);
 
@@ -92,21 +184,338 @@ public:
 	fillEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition = A);
 
 
+	template< PixelFormat SourceFormat >
+	void
+	drawImage(const Surface<SourceFormat> &image, const Point &destination, const CompositionOperator composition = A);
+
+	template< PixelFormat SourceFormat >
+	void
+	drawImage(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+			  const CompositionOperator composition = A);
+
+	// pixels of the color key are skipped
+	template< PixelFormat SourceFormat >
+	void
+	drawImage(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+			  const PixelColor<SourceFormat> colorKey, const CompositionOperator composition = A);
+
+	// the image is faded by the opacity first, 255 is fully opaque
+	template< PixelFormat SourceFormat >
+	void
+	drawImage(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+			  const uint8_t opacity, const CompositionOperator composition = AoverB);
+
+	// copies the image enlarged by an integer factor, converting every source pixel only once
+	template< PixelFormat SourceFormat >
+	void
+	drawImageScaled(const Surface<SourceFormat> &image, const Point &destination, const uint8_t factor);
+
+	// maps the image with the transform, which must be invertible
+	template< PixelFormat SourceFormat >
+	void
+	drawImage(const Surface<SourceFormat> &image, const Transform &transform,
+			  const Sampling sampling = Sampling::Nearest, const CompositionOperator composition = A);
+
+	// skip runs are not drawn
+	template< PixelFormat SourceFormat >
+	void
+	drawImage(const RleImage<SourceFormat> &image, const Point &destination, const CompositionOperator composition = A);
+
+
+	// bytes needed to save the pixels under the area
+	static inline std::size_t
+	getSaveSize(const Rect &area)
+	{ return (std::size_t(int16_t(area.getWidth()) + 1) * NativeColor::Bits + 7) / 8 * (int16_t(area.getHeight()) + 1); }
+
+	// Copies the pixels under the area into the buffer of `getSaveSize(area)`
+	// bytes, e.g. before a cursor or a moving object is drawn over them.
+	// The clip area does not apply, only pixels outside the surface are skipped.
+	void
+	saveUnder(const Rect &area, uint8_t *buffer) const;
+
+	// writes the pixels saved by `saveUnder()` for the same area back
+	void
+	restoreUnder(const Rect &area, const uint8_t *buffer);
+
+
+protected:
+	static constexpr std::size_t PointChunkSize = 128;
+	// the points of a chunk are bucketed into at most this many bands of rows of about this size
+	static constexpr uint8_t PointBands = 8;
+	static constexpr uint16_t PointBandBytes = 8192;
+
+	inline std::size_t
+	clipPointChunk(const Point *points, std::size_t count, uint8_t *visible);
+
+	static inline Rect
+	getBounds(const Point *points, std::size_t count);
+
+	// calls `function(index)` for every visible point, chunk by chunk and band by band
+	template< typename Function >
+	inline void
+	forEachVisiblePoint(const Point *points, std::size_t count, Function &&function);
+
+protected:
+	// accounts all work in its scope to the primitive, only the outermost
+	// primitive is counted, traced and recorded as damage, nothing without
+	// statistics, trace or damage
+	class Instrument
+	{
+	public:
+#if defined(MODM_GES_STATISTICS) or defined(MODM_GES_TRACE) or defined(MODM_GES_DAMAGE)
+		inline
+		Instrument(Painter &painter, Primitive primitive) :
+			painter(painter), isOutermost(painter.nesting++ == 0)
+		{
+			(void) primitive;
+			if (not isOutermost) return;
+#ifdef MODM_GES_STATISTICS
+			if (painter.statistics)
+			{
+				painter.counters = &(*painter.statistics)[primitive];
+				painter.counters->calls++;
+				if (painter.clock) start = painter.clock();
+			}
+#endif
+#ifdef MODM_GES_TRACE
+			name = PainterStatistics::getName(primitive);
+			if (painter.trace) traceStart = painter.trace->now();
+#endif
+		}
+
+		inline
+		~Instrument()
+		{
+			painter.nesting--;
+			if (not isOutermost) return;
+#ifdef MODM_GES_TRACE
+			if (painter.trace) painter.trace->record(name, TraceCategory::Painter, traceStart, painter.trace->now());
+#endif
+#ifdef MODM_GES_STATISTICS
+			if (painter.counters and painter.clock) painter.counters->time += painter.clock() - start;
+			painter.counters = nullptr;
+#endif
+		}
+
+		// bounds which are costly to compute are only needed then
+		inline bool
+		isDamaging() const
+		{
+#ifdef MODM_GES_DAMAGE
+			return isOutermost and painter.damage;
+#else
+			return false;
+#endif
+		}
+
+		// the primitive draws at most into the bounds
+		inline void
+		damage(const Rect &bounds) const
+		{
+			(void) bounds;
+#ifdef MODM_GES_DAMAGE
+			if (isDamaging()) painter.addDamage(bounds, painter.clipRect);
+#endif
+		}
+
+	private:
+		Painter &painter;
+		const bool isOutermost;
+#ifdef MODM_GES_STATISTICS
+		uint32_t start{0};
+#endif
+#ifdef MODM_GES_TRACE
+		const char *name{nullptr};
+		uint32_t traceStart{0};
+#endif
+#else
+		inline
+		Instrument(Painter &, Primitive) {}
+
+		static constexpr bool
+		isDamaging()
+		{ return false; }
+
+		inline void
+		damage(const Rect &) const {}
+#endif
+	};
+
+#ifdef MODM_GES_DAMAGE
+	inline void
+	addDamage(const Rect &bounds, const Rect &clip);
+#endif
+
+	// the saved pixels have the order of the surface, pages are saved in rows
+	inline NativeSurface
+	getSavedSurface(uint8_t *buffer, const Rect &area, std::true_type /* is packed */) const
+	{
+		const PixelOrder order = surface.getPixelOrder();
+		return NativeSurface(buffer, int16_t(area.getWidth()) + 1, int16_t(area.getHeight()) + 1,
+							 (order == PixelOrder::Pages) ? PixelOrder::LsbFirst : order);
+	}
+
+	inline NativeSurface
+	getSavedSurface(uint8_t *buffer, const Rect &area, std::false_type /* is packed */) const
+	{ return NativeSurface(buffer, int16_t(area.getWidth()) + 1, int16_t(area.getHeight()) + 1); }
+
+	inline void
+	countSpan(int16_t beginX, int16_t endX) const
+	{
+#ifdef MODM_GES_STATISTICS
+		if (counters and beginX <= endX) { counters->spans++; counters->pixels += endX - beginX + 1; }
+#else
+		(void) beginX; (void) endX;
+#endif
+	}
+
+	inline void
+	countPixels(int32_t pixels) const
+	{
+#ifdef MODM_GES_STATISTICS
+		if (counters) counters->pixels += pixels;
+#else
+		(void) pixels;
+#endif
+	}
+
+	inline void
+	countClipped(int32_t pixels) const
+	{
+#ifdef MODM_GES_STATISTICS
+		if (counters and pixels > 0) counters->clipped += pixels;
+#else
+		(void) pixels;
+#endif
+	}
+
 protected:
+	// Steps the circle rasterizer through one quadrant, one row at a time, so
+	// that corners give the same pixels as `drawCircle`.
+	struct QuarterCircle
+	{
+		QuarterCircle(int16_t radius) :
+			x(-radius), y(0), err(2 - 2 * radius) {}
+
+		// moves to the next row away from the center, returns its half width
+		inline int16_t
+		next()
+		{
+			const int16_t row = y;
+			while (y == row and x < 0)
+			{
+				const int16_t e = err;
+				if (e <= y) err += ++y * 2 + 1;
+				if (e > x or err > y) err += ++x * 2 + 1;
+			}
+			return -x;
+		}
+
+		int16_t x, y, err;
+	};
+
+	// draws the quadrant of the circle in the direction of the signs, without its end points
+	inline void
+	drawCorner(int16_t x, int16_t y, int16_t radius, int8_t signX, int8_t signY,
+			   const AlphaColor color, const CompositionOperator composition);
+
+	// draws the part of the row from -outer to outer around x without -inner to inner
+	inline void
+	drawSectorRow(const AngleRange &range, int16_t x, int16_t y, int16_t dy, int16_t outer, int16_t inner,
+				  const AlphaColor color, const CompositionOperator composition);
+
+	// draws the part of the row from begin to end around x, that the range contains
+	inline void
+	drawSectorSpan(const AngleRange &range, AngleRange::Coverage coverage, int16_t x, int16_t y, int16_t dy,
+				   int16_t begin, int16_t end, const AlphaColor color, const CompositionOperator composition);
+
+protected:
+	// Largest diameters for which all error terms of the ellipse rasterizers fit into
+	// 32bit, larger ones use 64bit. PainterTest compares both up to these limits.
+	static constexpr int16_t EvenEllipseLimit = 1435;
+	static constexpr int16_t OddEllipseLimit = 712;
+
+	template< typename Error >
 	inline void
 	drawEvenEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition);
 
+	template< typename Error >
 	inline void
 	drawOddEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition);
 
+	template< typename Error >
 	inline void
 	fillEvenEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition);
 
+	template< typename Error >
 	inline void
 	fillOddEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition);
 
 
 protected:
+	template< PixelFormat SourceFormat >
+	inline void
+	drawImageClipped(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+					 const CompositionOperator composition, const PixelColor<SourceFormat> *colorKey,
+					 const uint8_t opacity = 0xff);
+
+	// rows of the same byte aligned format can be copied directly
+	template< PixelFormat SourceFormat >
+	static constexpr bool
+	isCopyable()
+	{ return (SourceFormat == Format) and (NativeColor::Bits >= 8); }
+
+	// opaque rows of the native format are copied by the surface, with one memcpy
+	// for contiguous rows and without unpacking packed pixels,
+	// returns false if the span has to be drawn pixel by pixel
+	inline bool
+	copyNativeSpan(const NativeSurface &image, int16_t sx, int16_t sy, int16_t y, int16_t beginX, int16_t endX,
+				   const CompositionOperator composition, const NativeColor *colorKey);
+
+	template< PixelFormat SourceFormat >
+	inline bool
+	copyNativeSpan(const Surface<SourceFormat> &, int16_t, int16_t, int16_t, int16_t, int16_t,
+				   const CompositionOperator, const PixelColor<SourceFormat> *)
+	{ return false; }
+
+	// `pixelAt(ii)` returns the source pixel at `beginX + ii`, the source row
+	// at `pixels` is only copied directly if it has the native format
+	template< PixelFormat SourceFormat, typename Function >
+	inline void
+	drawPixelSpan(Function &&pixelAt, const void *pixels, int16_t y, int16_t beginX, int16_t endX,
+				  const CompositionOperator composition, const PixelColor<SourceFormat> *colorKey);
+
+	template< PixelFormat SourceFormat >
+	inline void
+	drawScaledSpan(const Surface<SourceFormat> &image, int16_t sy, int16_t dx, uint8_t factor,
+				   int16_t y, int16_t beginX, int16_t endX);
+
+	template< PixelFormat SourceFormat >
+	static inline AlphaColor
+	sampleBilinear(const Surface<SourceFormat> &image, int32_t u, int32_t v);
+
+	template< PixelFormat SourceFormat >
+	inline void
+	drawSolidSpan(const PixelColor<SourceFormat> pixel, int16_t y, int16_t beginX, int16_t endX,
+				  const CompositionOperator composition);
+
+protected:
+	inline uint8_t
+	getOutcode(int16_t x, int16_t y) const;
+
+	inline bool
+	isVisible(int16_t x, int16_t y) const;
+
+	inline void
+	drawLineClipped(int16_t bX, int16_t bY, int16_t eX, int16_t eY,
+					const AlphaColor color, const CompositionOperator composition,
+					bool skipBegin, bool skipEnd);
+
+	inline void
+	drawLineInWindow(const Rect &window, int16_t bX, int16_t bY, int16_t eX, int16_t eY,
+					 const AlphaColor color, const CompositionOperator composition,
+					 bool skipBegin, bool skipEnd);
+
 	inline void
 	drawHorizontalLineClipped(int16_t y, int16_t beginX, int16_t endX,
 							  const AlphaColor color, const CompositionOperator composition);
@@ -125,9 +534,66 @@ protected:
 	drawVerticalLine(int16_t x, int16_t beginY, int16_t endY,
 					 const AlphaColor color, const CompositionOperator composition);
 
+
+protected:
+	// calls `function(y, beginX, endX)` for every part of the row inside the clip region
+	template< typename Function >
+	inline void
+	forEachVisibleSpan(int16_t y, int16_t beginX, int16_t endX, Function &&function);
+
+	// alpha of opaque colors, converted only once since indexed colors search their palette
+	static inline auto
+	getOpaqueAlpha() -> decltype(AlphaColor().getAlpha())
+	{
+		static const auto opaque = AlphaColor(kColorBlack).getAlpha();
+		return opaque;
+	}
+
+	// the result does not depend on the destination, so spans are filled at once
+	static inline bool
+	isFill(const AlphaColor color, const CompositionOperator composition)
+	{
+		return composition == A or composition == Clear or
+			   (composition == AoverB and color.getAlpha() == getOpaqueAlpha());
+	}
+
+	inline void
+	drawHorizontalSpan(int16_t y, int16_t beginX, int16_t endX,
+					   const AlphaColor color, const CompositionOperator composition);
+
+	inline void
+	drawVerticalSpan(int16_t x, int16_t beginY, int16_t endY,
+					 const AlphaColor color, const CompositionOperator composition);
+
 private:
 	NativeSurface &surface;
 	Rect clipRect;
+	const Region *clipRegion;
+#ifdef MODM_GES_STATISTICS
+	PainterStatistics *statistics{nullptr};
+	PainterStatistics::Counters *counters{nullptr};
+	uint32_t (*clock)(){nullptr};
+#endif
+#ifdef MODM_GES_TRACE
+	Trace *trace{nullptr};
+#endif
+#ifdef MODM_GES_DAMAGE
+	Region *damage{nullptr};
+#endif
+#if defined(MODM_GES_STATISTICS) or defined(MODM_GES_TRACE) or defined(MODM_GES_DAMAGE)
+	uint8_t nesting{0};
+#endif
+#ifdef MODM_GES_DEBUG_OVERDRAW
+	uint8_t *writeCounters{nullptr};
+
+	inline void
+	countWrite(int16_t x, int16_t y)
+	{
+		if (writeCounters == nullptr) return;
+		uint8_t &count = writeCounters[int32_t(y) * surface.getWidth() + x];
+		if (count < 0xff) count++;
+	}
+#endif
 };
 
 } // namespace ges
@@ -10,6 +10,7 @@
 #endif
 
 #include <xpcc/architecture/utils.hpp>
+#include <type_traits>
 
 namespace modm { namespace ges {
 
@@ -44,13 +45,14 @@ const typename Painter<Format>::CompositionOperator Painter<Format>::Plus   {&Pa
 
 
 template< modm::ges::PixelFormat Format >
-modm::ges::Painter<Format>::Painter(NativeSurface &surface) : surface(surface), clipRect(surface.getBounds()) {}
+modm::ges::Painter<Format>::Painter(NativeSurface &surface) : surface(surface), clipRect(surface.getBounds()), clipRegion(nullptr) {}
 
 template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::setClipArea(const Rect &clip)
 {
 	clipRect = surface.clip(clip);
+	clipRegion = nullptr;
 }
 
 template< modm::ges::PixelFormat Format >
@@ -58,31 +60,279 @@ void
 modm::ges::Painter<Format>::resetClipArea()
 {
 	clipRect = surface.getBounds();
+	clipRegion = nullptr;
+}
+
+#ifdef MODM_GES_DAMAGE
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::addDamage(const Rect &bounds, const Rect &clip)
+{
+	if (not bounds.isValid() or not bounds.intersects(clip)) return;
+	damage->uniteOrBound(bounds.intersected(clip));
+}
+#endif
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::setClipRegion(const Region &region)
+{
+	// the bounding rectangle still rejects primitives early
+	clipRect = region.getBounds().intersected(surface.getBounds());
+	clipRegion = &region;
+}
+
+template< modm::ges::PixelFormat Format >
+bool
+modm::ges::Painter<Format>::isVisible(int16_t x, int16_t y) const
+{
+	const bool visible = clipRect.contains(x, y) and (likely(clipRegion == nullptr) or clipRegion->contains(x, y));
+	if (visible) countPixels(1);
+	else countClipped(1);
+	return visible;
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawPoints(const Point *points, std::size_t count, const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::Points);
+	if (unlikely(not clipRect.isValid())) return;
+	if (instrument.isDamaging() and count) instrument.damage(getBounds(points, count));
+
+	forEachVisiblePoint(points, count, [&](std::size_t index)
+	{
+		surface.compositePixel(int16_t(points[index].getX()), int16_t(points[index].getY()), color, composition);
+	});
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawPoints(const Point *points, const AlphaColor *colors, std::size_t count, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::Points);
+	if (unlikely(not clipRect.isValid())) return;
+	if (instrument.isDamaging() and count) instrument.damage(getBounds(points, count));
+
+	forEachVisiblePoint(points, count, [&](std::size_t index)
+	{
+		surface.compositePixel(int16_t(points[index].getX()), int16_t(points[index].getY()), colors[index], composition);
+	});
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::saveUnder(const Rect &area, uint8_t *buffer) const
+{
+	if (not area.isValid() or not area.intersects(surface.getBounds())) return;
+	const Rect clipped = area.intersected(surface.getBounds());
+	NativeSurface saved = getSavedSurface(buffer, area, std::integral_constant<bool, (NativeColor::Bits < 8)>());
+
+	// rows are copied bytewise, packed rows shifted to the left of the buffer
+	const int16_t top = area.getTop();
+	const int16_t left = clipped.getLeft();
+	const int16_t width = int16_t(clipped.getWidth()) + 1;
+	for (int16_t y = clipped.getTop(); y <= int16_t(clipped.getBottom()); y++)
+	{
+		saved.copySpan(y - top, left - int16_t(area.getLeft()), surface, left, y, width);
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::restoreUnder(const Rect &area, const uint8_t *buffer)
+{
+	if (not area.isValid() or not area.intersects(surface.getBounds())) return;
+	const Rect clipped = area.intersected(surface.getBounds());
+	// the saved pixels are only read
+	const NativeSurface saved = getSavedSurface(const_cast<uint8_t*>(buffer), area,
+												std::integral_constant<bool, (NativeColor::Bits < 8)>());
+
+	const int16_t top = area.getTop();
+	const int16_t left = clipped.getLeft();
+	const int16_t width = int16_t(clipped.getWidth()) + 1;
+	for (int16_t y = clipped.getTop(); y <= int16_t(clipped.getBottom()); y++)
+	{
+		surface.copySpan(y, left, saved, left - int16_t(area.getLeft()), y - top, width);
+	}
+#ifdef MODM_GES_DAMAGE
+	if (damage) addDamage(clipped, surface.getBounds());
+#endif
+}
+
+template< modm::ges::PixelFormat Format >
+modm::ges::Rect
+modm::ges::Painter<Format>::getBounds(const Point *points, std::size_t count)
+{
+	Point topLeft = points[0], bottomRight = points[0];
+	for (std::size_t ii = 1; ii < count; ii++)
+	{
+		topLeft = Point(xpcc::min(topLeft.getX(), points[ii].getX()), xpcc::min(topLeft.getY(), points[ii].getY()));
+		bottomRight = Point(xpcc::max(bottomRight.getX(), points[ii].getX()), xpcc::max(bottomRight.getY(), points[ii].getY()));
+	}
+	return Rect(topLeft, bottomRight);
+}
+
+template< modm::ges::PixelFormat Format >
+std::size_t
+modm::ges::Painter<Format>::clipPointChunk(const Point *points, std::size_t count, uint8_t *visible)
+{
+	const int16_t cl = clipRect.getLeft();
+	const int16_t ct = clipRect.getTop();
+	const uint16_t cw = int16_t(clipRect.getRight()) - cl;
+	const uint16_t ch = int16_t(clipRect.getBottom()) - ct;
+
+	std::size_t size = 0;
+	for (std::size_t ii = 0; ii < count; ii++)
+	{
+		// a single unsigned compare per axis tests both edges of the clip
+		// window, and the index is always written, but only kept if visible.
+		// Without any branches the compiler is free to vectorize this loop.
+		const bool inside = (uint16_t(int16_t(points[ii].getX()) - cl) <= cw) &
+							(uint16_t(int16_t(points[ii].getY()) - ct) <= ch);
+		visible[size] = ii;
+		size += inside;
+	}
+
+	if (unlikely(clipRegion != nullptr))
+	{
+		std::size_t kept = 0;
+		for (std::size_t ii = 0; ii < size; ii++)
+		{
+			const Point &p = points[visible[ii]];
+			visible[kept] = visible[ii];
+			kept += clipRegion->contains(int16_t(p.getX()), int16_t(p.getY()));
+		}
+		size = kept;
+	}
+	return size;
+}
+
+template< modm::ges::PixelFormat Format >
+template< typename Function >
+void
+modm::ges::Painter<Format>::forEachVisiblePoint(const Point *points, std::size_t count, Function &&function)
+{
+	const int16_t top = clipRect.getTop();
+	const uint16_t height = int16_t(clipRect.getBottom()) - top;
+
+	// Scattered points on large surfaces are bucketed by bands of rows within
+	// each chunk, so that consecutive writes stay within a few kilobytes of
+	// the buffer. The buckets are stable, coincident points keep their order.
+	const uint32_t rowBytes = (uint32_t(surface.getWidth()) * NativeColor::Bits + 7) / 8;
+	uint8_t shift = 0;
+	while (shift < 15 and (rowBytes << (shift + 1)) <= PointBandBytes) shift++;
+	while ((height >> shift) >= PointBands) shift++;
+	const bool banded = (height >> shift) > 0;
+
+	std::size_t drawn = 0;
+	uint8_t visible[PointChunkSize];
+	uint8_t order[PointChunkSize];
+	for (std::size_t offset = 0; offset < count; offset += PointChunkSize)
+	{
+		const Point *chunk = points + offset;
+		const std::size_t size = clipPointChunk(chunk, (count - offset < PointChunkSize) ? count - offset : PointChunkSize, visible);
+		const uint8_t *sorted = visible;
+		if (banded and size > 1)
+		{
+			// counting sort of the visible indices by band
+			uint8_t start[PointBands + 1] = {};
+			for (std::size_t ii = 0; ii < size; ii++)
+				start[(uint16_t(int16_t(chunk[visible[ii]].getY()) - top) >> shift) + 1]++;
+			for (uint8_t band = 1; band < PointBands; band++)
+				start[band] += start[band - 1];
+			for (std::size_t ii = 0; ii < size; ii++)
+				order[start[uint16_t(int16_t(chunk[visible[ii]].getY()) - top) >> shift]++] = visible[ii];
+			sorted = order;
+		}
+		for (std::size_t ii = 0; ii < size; ii++)
+			function(offset + sorted[ii]);
+		drawn += size;
+	}
+	countPixels(drawn);
+	countClipped(count - drawn);
 }
 
 template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::drawLine(const Line &line, const AlphaColor color, CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::Line);
 	if (line.isNull()) return;
+	instrument.damage(line.getBounds().normalized());
+
+	const Line l = line.normalized();
+	drawLineClipped(l.getX1(), l.getY1(), l.getX2(), l.getY2(), color, composition, false, false);
+}
 
-	int16_t bX, bY, eX, eY;
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawPolyline(const Point *points, std::size_t count, const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::Polyline);
+	if (unlikely(count == 0 or not clipRect.isValid())) return;
+	if (instrument.isDamaging()) instrument.damage(getBounds(points, count));
+
+	// Cohen-Sutherland outcodes are computed once per vertex and carried over
+	// to the next segment, so invisible runs are skipped with a single AND.
+	int16_t bX = points[0].getX();
+	int16_t bY = points[0].getY();
+	uint8_t bCode = getOutcode(bX, bY);
+	bool segments = false;
+
+	for (std::size_t ii = 1; ii < count; ii++)
 	{
-		const Line l = line.normalized();
+		const int16_t eX = points[ii].getX();
+		const int16_t eY = points[ii].getY();
+		// repeated vertices are simply skipped
+		if (eX == bX and eY == bY) continue;
+		const uint8_t eCode = getOutcode(eX, eY);
+		segments = true;
+
+		if (not (bCode & eCode))
+		{
+			// the end point is left out, since it is the begin of the next segment
+			if (bX <= eX) drawLineClipped(bX, bY, eX, eY, color, composition, false, true);
+			else          drawLineClipped(eX, eY, bX, bY, color, composition, true, false);
+		}
+
+		bX = eX; bY = eY; bCode = eCode;
+	}
 
-		bX = l.getX1();
-		bY = l.getY1();
-		eX = l.getX2();
-		eY = l.getY2();
+	// finally draw the last vertex, unless the first segment already drew it
+	if (bCode == 0 and isVisible(bX, bY) and (not segments or bX != int16_t(points[0].getX()) or bY != int16_t(points[0].getY())))
+	{
+		surface.compositePixel(bX, bY, color, composition);
 	}
+}
+
+template< modm::ges::PixelFormat Format >
+uint8_t
+modm::ges::Painter<Format>::getOutcode(int16_t x, int16_t y) const
+{
+	return  (x < clipRect.getLeft()   ? 0b0001 : 0) |
+			(x > clipRect.getRight()  ? 0b0010 : 0) |
+			(y < clipRect.getTop()    ? 0b0100 : 0) |
+			(y > clipRect.getBottom() ? 0b1000 : 0);
+}
 
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawLineClipped(int16_t bX, int16_t bY, int16_t eX, int16_t eY,
+											const AlphaColor color, const CompositionOperator composition,
+											bool skipBegin, bool skipEnd)
+{
 	// check if line is vertical
 	if (unlikely(bX == eX))
 	{
 		// check if line is vertically within clipping
 		if (bX < clipRect.getLeft() or bX > clipRect.getRight()) return;
 		// order correctly
-		if (eY < bY) std::swap(bY, eY);
+		if (eY < bY) { std::swap(bY, eY); std::swap(skipBegin, skipEnd); }
+		// leave out shared end points
+		if (skipBegin) bY++;
+		if (skipEnd) eY--;
+		if (eY < bY) return;
 		// check if line is horizintally within clipping
 		if (eY < clipRect.getTop() or bY > clipRect.getBottom()) return;
 
@@ -100,7 +350,11 @@ modm::ges::Painter<Format>::drawLine(const Line &line, const AlphaColor color, C
 		// check if line is horizontally within clipping
 		if (bY < clipRect.getTop() or bY > clipRect.getBottom()) return;
 		// order correctly
-		if (eX < bX) std::swap(bX, eX);
+		if (eX < bX) { std::swap(bX, eX); std::swap(skipBegin, skipEnd); }
+		// leave out shared end points
+		if (skipBegin) bX++;
+		if (skipEnd) eX--;
+		if (eX < bX) return;
 		// check if line is vertically within clipping
 		if (eX < clipRect.getLeft() or bX > clipRect.getRight()) return;
 
@@ -112,15 +366,39 @@ modm::ges::Painter<Format>::drawLine(const Line &line, const AlphaColor color, C
 		return;
 	}
 
+	if (likely(clipRegion == nullptr))
+	{
+		drawLineInWindow(clipRect, bX, bY, eX, eY, color, composition, skipBegin, skipEnd);
+		return;
+	}
+
+	// the line is clipped against every rectangle of the region on its own.
+	// Since the rectangles do not overlap, no pixel is drawn twice.
+	for (uint8_t ii = 0; ii < clipRegion->count; ii++)
+	{
+		const Rect window = clipRegion->boxes[ii].toRect().intersected(clipRect);
+		if (window.isValid())
+		{
+			drawLineInWindow(window, bX, bY, eX, eY, color, composition, skipBegin, skipEnd);
+		}
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawLineInWindow(const Rect &window, int16_t bX, int16_t bY, int16_t eX, int16_t eY,
+											 const AlphaColor color, const CompositionOperator composition,
+											 bool skipBegin, bool skipEnd)
+{
 	{
 		// code below is based directly on the paper:
 		// Yevgeny P. Kuzmin. Bresenham's Line Generation Algorithm with
 		// Built-in Clipping. Computer Graphics Forum, 14(5):275--280, 2005.
 
-		int16_t wbX = clipRect.getLeft();
-		int16_t wbY = clipRect.getTop();
-		int16_t weX = clipRect.getRight();
-		int16_t weY = clipRect.getBottom();
+		int16_t wbX = window.getLeft();
+		int16_t wbY = window.getTop();
+		int16_t weX = window.getRight();
+		int16_t weY = window.getBottom();
 
 		int16_t xd;
 		int16_t yd;
@@ -242,7 +520,10 @@ modm::ges::Painter<Format>::drawLine(const Line &line, const AlphaColor color, C
 		}
 
 		if (term > weX) term = weX;
-		term++;
+		// the end point is only left out if it is visible at all
+		if (not (skipEnd and eX <= weX and eY <= weY)) term++;
+		// the begin point is only left out if it is visible at all
+		skipBegin = skipBegin and bX >= wbX and bY >= wbY;
 
 		if (sty == -1) yd = -yd;
 
@@ -252,6 +533,20 @@ modm::ges::Painter<Format>::drawLine(const Line &line, const AlphaColor color, C
 		}
 		dx2 -= dy2;
 
+		if (skipBegin)
+		{
+			if (e >= 0)
+			{
+				yd += sty;
+				e -= dx2;
+			}
+			else {
+				e += dy2;
+			}
+
+			xd += stx;
+		}
+
 		// bresenham line drawing
 		while (xd != term)
 		{
@@ -259,6 +554,7 @@ modm::ges::Painter<Format>::drawLine(const Line &line, const AlphaColor color, C
 			// they are in a reasonable range -- it could cause integer overflow
 			// in this function
 			surface.compositePixel(*d0, *d1, color, composition);
+			countPixels(1);
 
 			if (e >= 0)
 			{
@@ -279,8 +575,10 @@ template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::drawRect(const Rect &rectangle, const AlphaColor color, const CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::Rect);
 	// don't even bother if rect is not in clip area
 	if (unlikely(clipRect.isEmpty() or not clipRect.intersects(rectangle))) return;
+	instrument.damage(rectangle);
 
 //		int16_t cl = clipRect.getLeft();	// save some stack
 //		int16_t ct = clipRect.getTop();		// save some stack
@@ -320,8 +618,12 @@ template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::fillRect(const Rect &rectangle, const AlphaColor color, const CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::FillRect);
+	instrument.damage(rectangle);
 	Rect clip = rectangle.intersected(clipRect);
 	// there is no need to test for isEmpty() !
+	countClipped((int32_t(rectangle.getWidth()) + 1) * (int32_t(rectangle.getHeight()) + 1) -
+				 (int32_t(clip.getWidth()) + 1) * (int32_t(clip.getHeight()) + 1));
 
 	for (int16_t yy = clip.getTop(); yy <= clip.getBottom(); yy++)
 	{
@@ -330,12 +632,130 @@ modm::ges::Painter<Format>::fillRect(const Rect &rectangle, const AlphaColor col
 }
 
 
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawRoundedRect(const RoundedRect &rectangle, const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::RoundedRect);
+	const Rect rect = rectangle.getRect();
+	if (unlikely(not rect.isValid() or clipRect.isEmpty() or not clipRect.intersects(rect))) return;
+	instrument.damage(rect);
+
+	const int16_t rTL = rectangle.getRadius(RoundedRect::TopLeft);
+	const int16_t rTR = rectangle.getRadius(RoundedRect::TopRight);
+	const int16_t rBR = rectangle.getRadius(RoundedRect::BottomRight);
+	const int16_t rBL = rectangle.getRadius(RoundedRect::BottomLeft);
+	if (not (rTL or rTR or rBR or rBL))
+	{
+		drawRect(rect, color, composition);
+		return;
+	}
+
+	const int16_t left = rect.getLeft(), top = rect.getTop();
+	const int16_t right = rect.getRight(), bottom = rect.getBottom();
+
+	// The horizontal edges end at the corner centers, the vertical edges
+	// include the first corner pixel, so every pixel is drawn only once.
+	drawHorizontalLineClipped(top, left + rTL, right - rTR, color, composition);
+	drawHorizontalLineClipped(bottom, left + rBL, right - rBR, color, composition);
+	drawVerticalLineClipped(left, top + xpcc::max(rTL, int16_t(1)), bottom - xpcc::max(rBL, int16_t(1)), color, composition);
+	drawVerticalLineClipped(right, top + xpcc::max(rTR, int16_t(1)), bottom - xpcc::max(rBR, int16_t(1)), color, composition);
+
+	// corners outside the clip area are skipped completely
+	if (rTL and clipRect.intersects(Rect(left, top, rTL, rTL)))
+		drawCorner(left + rTL, top + rTL, rTL, 1, -1, color, composition);
+	if (rTR and clipRect.intersects(Rect(right - rTR, top, rTR, rTR)))
+		drawCorner(right - rTR, top + rTR, rTR, -1, -1, color, composition);
+	if (rBR and clipRect.intersects(Rect(right - rBR, bottom - rBR, rBR, rBR)))
+		drawCorner(right - rBR, bottom - rBR, rBR, -1, 1, color, composition);
+	if (rBL and clipRect.intersects(Rect(left, bottom - rBL, rBL, rBL)))
+		drawCorner(left + rBL, bottom - rBL, rBL, 1, 1, color, composition);
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawCorner(int16_t x, int16_t y, int16_t radius, int8_t signX, int8_t signY,
+									   const AlphaColor color, const CompositionOperator composition)
+{
+	int16_t dx = -radius;
+	int16_t dy = 0;
+	int16_t err = 2 - 2 * radius;
+
+	while (true)
+	{
+		const int16_t e = err;
+		if (e <= dy) err += ++dy * 2 + 1;
+		if (e > dx or err > dy) err += ++dx * 2 + 1;
+		if (dx >= 0) break;
+
+		const int16_t px = x + signX * dx, py = y + signY * dy;
+		if (isVisible(px, py)) surface.compositePixel(px, py, color, composition);
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::fillRoundedRect(const RoundedRect &rectangle, const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::FillRoundedRect);
+	const Rect rect = rectangle.getRect();
+	if (unlikely(not rect.isValid() or clipRect.isEmpty() or not clipRect.intersects(rect))) return;
+	instrument.damage(rect);
+
+	const int16_t rTL = rectangle.getRadius(RoundedRect::TopLeft);
+	const int16_t rTR = rectangle.getRadius(RoundedRect::TopRight);
+	const int16_t rBR = rectangle.getRadius(RoundedRect::BottomRight);
+	const int16_t rBL = rectangle.getRadius(RoundedRect::BottomLeft);
+	if (not (rTL or rTR or rBR or rBL))
+	{
+		fillRect(rect, color, composition);
+		return;
+	}
+
+	const int16_t left = rect.getLeft(), top = rect.getTop();
+	const int16_t right = rect.getRight(), bottom = rect.getBottom();
+	const int16_t topRows = xpcc::max(rTL, rTR);
+	const int16_t bottomRows = xpcc::max(rBL, rBR);
+
+	// Every row is a single span between the corners, so nothing is composited twice.
+	// The corner rows are walked outwards from the corner centers.
+	{
+		QuarterCircle cornerLeft(rTL), cornerRight(rTR);
+		for (int16_t y = top + topRows - 1; y >= top; y--)
+		{
+			const int16_t beginX = (y < top + rTL) ? left + rTL - cornerLeft.next() : left;
+			const int16_t endX = (y < top + rTR) ? right - rTR + cornerRight.next() : right;
+			drawHorizontalLineClipped(y, beginX, endX, color, composition);
+		}
+	}
+	{
+		QuarterCircle cornerLeft(rBL), cornerRight(rBR);
+		for (int16_t y = bottom - bottomRows + 1; y <= bottom; y++)
+		{
+			const int16_t beginX = (y > bottom - rBL) ? left + rBL - cornerLeft.next() : left;
+			const int16_t endX = (y > bottom - rBR) ? right - rBR + cornerRight.next() : right;
+			drawHorizontalLineClipped(y, beginX, endX, color, composition);
+		}
+	}
+
+	// the straight middle only needs the rows inside the clip area
+	const int16_t beginX = xpcc::max(left, int16_t(clipRect.getLeft()));
+	const int16_t endX = xpcc::min(right, int16_t(clipRect.getRight()));
+	const int16_t endY = xpcc::min(int16_t(bottom - bottomRows), int16_t(clipRect.getBottom()));
+	for (int16_t y = xpcc::max(int16_t(top + topRows), int16_t(clipRect.getTop())); y <= endY; y++)
+	{
+		drawHorizontalLine(y, beginX, endX, color, composition);
+	}
+}
+
 template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::drawCircle(const Circle &circle, const AlphaColor color, const CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::Circle);
 	// we don't draw empty circles
 	if (unlikely(not circle.isValid())) return;
+	instrument.damage(circle.getBounds());
 
 	// only draw intersecting circles
 	if (unlikely(not circle.intersects(clipRect))) return;
@@ -364,10 +784,10 @@ modm::ges::Painter<Format>::drawCircle(const Circle &circle, const AlphaColor co
 		 * I haven't found a good arc rasterization algorithm based on this one yet,
 		 * so this uses the cheesy guard band clipping way for every pixel.
 		 */
-		if (clipRect.contains(circle.getX() - x, circle.getY() + y)) surface.compositePixel(circle.getX() - x, circle.getY() + y, color, composition);	//   I. Quadrant +x +y
-		if (clipRect.contains(circle.getX() - y, circle.getY() - x)) surface.compositePixel(circle.getX() - y, circle.getY() - x, color, composition);	//  II. Quadrant -x +y
-		if (clipRect.contains(circle.getX() + x, circle.getY() - y)) surface.compositePixel(circle.getX() + x, circle.getY() - y, color, composition);	// III. Quadrant -x -y
-		if (clipRect.contains(circle.getX() + y, circle.getY() + x)) surface.compositePixel(circle.getX() + y, circle.getY() + x, color, composition);	//  IV. Quadrant +x -y
+		if (isVisible(circle.getX() - x, circle.getY() + y)) surface.compositePixel(circle.getX() - x, circle.getY() + y, color, composition);	//   I. Quadrant +x +y
+		if (isVisible(circle.getX() - y, circle.getY() - x)) surface.compositePixel(circle.getX() - y, circle.getY() - x, color, composition);	//  II. Quadrant -x +y
+		if (isVisible(circle.getX() + x, circle.getY() - y)) surface.compositePixel(circle.getX() + x, circle.getY() - y, color, composition);	// III. Quadrant -x -y
+		if (isVisible(circle.getX() + y, circle.getY() + x)) surface.compositePixel(circle.getX() + y, circle.getY() + x, color, composition);	//  IV. Quadrant +x -y
 
 		r = err;
 
@@ -384,8 +804,10 @@ template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::fillCircle(const Circle &circle, const AlphaColor color, const CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::FillCircle);
 	// we don't draw empty circles
 	if (unlikely(not circle.isValid())) return;
+	instrument.damage(circle.getBounds());
 
 	// only draw intersecting circles
 	if (unlikely(not circle.intersects(clipRect))) return;
@@ -396,45 +818,218 @@ modm::ges::Painter<Format>::fillCircle(const Circle &circle, const AlphaColor co
 		return;
 	}
 
-	// start the drawing
-	int16_t r = circle.getRadius();
-	int16_t x = -r;
-	int16_t y = 1;
-	int16_t err = 2 - 2 * r;
-	int16_t prevY = 0;
+	// start the drawing with exactly one span per row, from the origin outwards
+	const int16_t r = circle.getRadius();
+	const int16_t cx = circle.getX();
+	const int16_t cy = circle.getY();
+	QuarterCircle quarter(r);
 
-	drawHorizontalLineClipped(circle.getY(), circle.getX() - r, circle.getX() + r, color, composition);
+	drawHorizontalLineClipped(cy, cx - r, cx + r, color, composition);
 
-	do
+	for (int16_t y = 1; y <= r; y++)
+	{
+		const int16_t x = quarter.next();
+		// below origin, left to right
+		drawHorizontalLineClipped(cy + y, cx - x, cx + x, color, composition);
+		// above origin, left to right
+		drawHorizontalLineClipped(cy - y, cx - x, cx + x, color, composition);
+	}
+}
+
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawArc(const Circle &circle, const angle_t start, const angle_t end,
+									const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::Arc);
+	if (unlikely(not circle.isValid() or not circle.intersects(clipRect))) return;
+	instrument.damage(circle.getBounds());
+
+	const AngleRange range(start, end);
+	if (range.isFull())
+	{
+		drawCircle(circle, color, composition);
+		return;
+	}
+	if (range.isEmpty()) return;
+
+	const int16_t cx = circle.getX();
+	const int16_t cy = circle.getY();
+	if (unlikely(circle.isNull()))
 	{
-		if (y != prevY)
+		surface.compositePixel(cx, cy, color, composition);
+		return;
+	}
+
+	// Same walk as `drawCircle`, but the outline is drawn as the runs of its
+	// rows in each quadrant. Runs in uncovered octants are skipped, and only
+	// the runs in partially covered octants are clipped at the angles.
+	static constexpr int8_t signs[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+	// the octant next to the x axis and the one next to the y axis
+	static constexpr uint8_t octants[4][2] = {{0, 1}, {3, 2}, {4, 5}, {7, 6}};
+	AngleRange::Coverage flat[4], steep[4];
+	// only the quadrants with covered octants are drawn
+	uint8_t quadrants[4], count = 0;
+	bool hasSteep = false;
+	for (uint8_t quadrant = 0; quadrant < 4; quadrant++)
+	{
+		flat[quadrant] = range.getCoverage(octants[quadrant][0]);
+		steep[quadrant] = range.getCoverage(octants[quadrant][1]);
+		if (flat[quadrant] != AngleRange::Coverage::None or steep[quadrant] != AngleRange::Coverage::None)
+			quadrants[count++] = quadrant;
+		hasSteep |= (steep[quadrant] != AngleRange::Coverage::None);
+	}
+
+	const int16_t radius = circle.getRadius();
+	int16_t x = -radius;
+	int16_t y = 0;
+	int16_t err = 2 - 2 * radius;
+
+	for (int16_t dy = 0; dy <= radius; dy++)
+	{
+		const int16_t outer = -x;
+		// beyond the diagonal only the octants next to the y axis remain
+		if (outer < dy and not hasSteep) break;
+		int16_t inner = outer;
+		while (y == dy and x < 0)
 		{
-			// above origin, left to right
-			drawHorizontalLineClipped(circle.getY() + y, circle.getX() + x, circle.getX() - x, color, composition);
-			// below left to right
-			drawHorizontalLineClipped(circle.getY() - y, circle.getX() + x, circle.getX() - x, color, composition);
-			prevY = y;
+			inner = -x;
+			const int16_t e = err;
+			if (e <= y) err += ++y * 2 + 1;
+			if (e > x or err > y) err += ++x * 2 + 1;
 		}
+		// the last row reaches the axis
+		if (y == dy) inner = 0;
 
-		r = err;
+		for (uint8_t ii = 0; ii < count; ii++)
+		{
+			// the origin row is drawn once
+			const uint8_t quadrant = quadrants[ii];
+			if (quadrant >= 2 and dy == 0) break;
+			const int16_t row = cy + signs[quadrant][1] * dy;
+			if (row < clipRect.getTop() or row > clipRect.getBottom()) continue;
+
+			// the axis pixels belong to the right quadrants
+			const int16_t near = (signs[quadrant][0] < 0) ? xpcc::max(inner, int16_t(1)) : inner;
+			if (near > outer) continue;
+			const int16_t begin = (signs[quadrant][0] < 0) ? -outer : near;
+			const int16_t end   = (signs[quadrant][0] < 0) ? -near : outer;
+
+			// runs within one octant take its coverage
+			const AngleRange::Coverage coverage = (near >= dy) ? flat[quadrant] : (outer <= dy) ? steep[quadrant] :
+					(flat[quadrant] == steep[quadrant]) ? flat[quadrant] : AngleRange::Coverage::Partial;
+
+			if (begin == end)
+			{
+				if (coverage == AngleRange::Coverage::None) continue;
+				if (coverage == AngleRange::Coverage::Partial and not range.contains(begin, row - cy)) continue;
+				if (isVisible(cx + begin, row)) surface.compositePixel(cx + begin, row, color, composition);
+			}
+			else drawSectorSpan(range, coverage, cx, row, row - cy, begin, end, color, composition);
+		}
+	}
+}
 
-		if (r <= y) err += ++y * 2 + 1;		// e_xy + e_y < 0
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::fillPie(const Circle &circle, const angle_t start, const angle_t end,
+									const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::Pie);
+	instrument.damage(circle.getBounds());
+	fillRing(circle, 0, start, end, color, composition);
+}
 
-		if (r > x or err > y)
-		{			// e_xy + e_x > 0 or no 2nd y-step
-			err += ++x * 2 + 1;				// -> x-step now
-		}
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::fillRing(const Circle &circle, const int16_t innerRadius, const angle_t start, const angle_t end,
+									 const AlphaColor color, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::Ring);
+	if (unlikely(not circle.isValid() or not circle.intersects(clipRect))) return;
+	instrument.damage(circle.getBounds());
+
+	const AngleRange range(start, end);
+	if (range.isEmpty()) return;
+
+	const int16_t cx = circle.getX();
+	const int16_t cy = circle.getY();
+	const int16_t radius = circle.getRadius();
+	// the hole is the filled circle just inside the inner radius
+	const int16_t hole = innerRadius - 1;
+	if (hole >= radius) return;
+
+	// both circles are walked outwards from the origin row, so that their
+	// outlines are the same as of `drawCircle`
+	QuarterCircle outerCircle(radius), innerCircle(xpcc::max(hole, int16_t(0)));
+	int16_t outer = radius;
+	int16_t inner = hole;
+
+	drawSectorRow(range, cx, cy, 0, outer, inner, color, composition);
+	for (int16_t dy = 1; dy <= radius; dy++)
+	{
+		outer = outerCircle.next();
+		inner = (dy <= hole) ? innerCircle.next() : -1;
+
+		drawSectorRow(range, cx, cy + dy,  dy, outer, inner, color, composition);
+		drawSectorRow(range, cx, cy - dy, -dy, outer, inner, color, composition);
 	}
-	while (x < 0);
 }
 
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawSectorRow(const AngleRange &range, int16_t x, int16_t y, int16_t dy, int16_t outer, int16_t inner,
+										  const AlphaColor color, const CompositionOperator composition)
+{
+	if (y < clipRect.getTop() or y > clipRect.getBottom()) return;
+
+	// the spans left and right of the origin are limited by the octants on their side
+	if (inner < 0)
+	{
+		drawSectorSpan(range, range.getRowCoverage(dy), x, y, dy, -outer, outer, color, composition);
+		return;
+	}
+	drawSectorSpan(range, range.getRowCoverage(dy, false), x, y, dy, -outer, -inner - 1, color, composition);
+	drawSectorSpan(range, range.getRowCoverage(dy, true), x, y, dy, inner + 1, outer, color, composition);
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawSectorSpan(const AngleRange &range, AngleRange::Coverage coverage, int16_t x, int16_t y, int16_t dy,
+										   int16_t begin, int16_t end, const AlphaColor color, const CompositionOperator composition)
+{
+	if (coverage == AngleRange::Coverage::None or begin > end) return;
+	if (coverage == AngleRange::Coverage::Full)
+	{
+		drawHorizontalLineClipped(y, x + begin, x + end, color, composition);
+		return;
+	}
+
+	const AngleRange::Span limit = range.getSpan(dy);
+	if (not limit.inverted)
+	{
+		drawHorizontalLineClipped(y, x + std::max(begin, limit.begin), x + std::min(end, limit.end), color, composition);
+	}
+	else if (limit.begin > limit.end)
+	{
+		drawHorizontalLineClipped(y, x + begin, x + end, color, composition);
+	}
+	else
+	{
+		drawHorizontalLineClipped(y, x + begin, x + std::min(end, int16_t(limit.begin - 1)), color, composition);
+		drawHorizontalLineClipped(y, x + std::max(begin, int16_t(limit.end + 1)), x + end, color, composition);
+	}
+}
 
 template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::drawEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::Ellipse);
 	// we don't draw empty circles
 	if (unlikely(not ellipse.isValid())) return;
+	instrument.damage(ellipse.getBounds());
 
 	// only draw intersecting circles
 	if (unlikely(not ellipse.intersects(clipRect))) return;
@@ -445,17 +1040,25 @@ modm::ges::Painter<Format>::drawEllipse(const Ellipse &ellipse, const AlphaColor
 		return;
 	}
 
+	const int16_t diameter = xpcc::max(int16_t(ellipse.getWidth()), int16_t(ellipse.getHeight()));
 	if (ellipse.isEven())
 	{
-		drawEvenEllipse(ellipse, color, composition);
+		if (likely(diameter <= EvenEllipseLimit))
+			drawEvenEllipse<int32_t>(ellipse, color, composition);
+		else
+			drawEvenEllipse<int64_t>(ellipse, color, composition);
 	}
 	else
 	{
-		drawOddEllipse(ellipse, color, composition);
+		if (likely(diameter <= OddEllipseLimit))
+			drawOddEllipse<int32_t>(ellipse, color, composition);
+		else
+			drawOddEllipse<int64_t>(ellipse, color, composition);
 	}
 }
 
 template< modm::ges::PixelFormat Format >
+template< typename Error >
 void
 modm::ges::Painter<Format>::drawEvenEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition)
 {
@@ -463,20 +1066,20 @@ modm::ges::Painter<Format>::drawEvenEllipse(const Ellipse &ellipse, const AlphaC
 	int16_t b = ellipse.getHeight() / 2;
 
 	int32_t x = -a, y = 0;					// II. quadrant from bottom left to top right
-	int32_t e2 = b, dx = (1+2*x)*e2*e2;	// error increment
-	int32_t dy = x*x, err = dx+dy;			// error of 1.step
+	Error e2 = b, dx = (1+2*x)*e2*e2;		// error increment
+	Error dy = Error(x)*x, err = dx+dy;		// error of 1.step
 	int16_t xm = ellipse.getX() + a;
 	int16_t ym = ellipse.getY() + b;
 
 	do {
-		if (clipRect.contains(xm-x, ym+y)) surface.compositePixel(xm-x, ym+y, color, composition);	//   I. Quadrant
-		if (clipRect.contains(xm+x, ym+y)) surface.compositePixel(xm+x, ym+y, color, composition);	//  II. Quadrant
-		if (clipRect.contains(xm+x, ym-y)) surface.compositePixel(xm+x, ym-y, color, composition);	// III. Quadrant
-		if (clipRect.contains(xm-x, ym-y)) surface.compositePixel(xm-x, ym-y, color, composition);	//  IV. Quadrant
+		if (isVisible(xm-x, ym+y)) surface.compositePixel(xm-x, ym+y, color, composition);	//   I. Quadrant
+		if (isVisible(xm+x, ym+y)) surface.compositePixel(xm+x, ym+y, color, composition);	//  II. Quadrant
+		if (isVisible(xm+x, ym-y)) surface.compositePixel(xm+x, ym-y, color, composition);	// III. Quadrant
+		if (isVisible(xm-x, ym-y)) surface.compositePixel(xm-x, ym-y, color, composition);	//  IV. Quadrant
 
 		e2 = 2*err;
-		if (e2 >= dx) { x++; err += dx += 2*int32_t(b)*b; }	// x step
-		if (e2 <= dy) { y++; err += dy += 2*int32_t(a)*a; }	// y step
+		if (e2 >= dx) { x++; err += dx += 2*Error(b)*b; }	// x step
+		if (e2 <= dy) { y++; err += dy += 2*Error(a)*a; }	// y step
 	}
 	while (x <= 0);
 
@@ -486,13 +1089,14 @@ modm::ges::Painter<Format>::drawEvenEllipse(const Ellipse &ellipse, const AlphaC
 		while (y++ < b)
 		{
 			// -> finish tip of ellipse
-			if (ym+y >= clipRect.getTop() and ym+y <= clipRect.getBottom()) surface.compositePixel(xm, ym+y, color, composition);
-			if (ym-y >= clipRect.getTop() and ym-y <= clipRect.getBottom()) surface.compositePixel(xm, ym-y, color, composition);
+			if (isVisible(xm, ym+y)) surface.compositePixel(xm, ym+y, color, composition);
+			if (isVisible(xm, ym-y)) surface.compositePixel(xm, ym-y, color, composition);
 		}
 	}
 }
 
 template< modm::ges::PixelFormat Format >
+template< typename Error >
 void
 modm::ges::Painter<Format>::drawOddEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition)
 {
@@ -502,21 +1106,22 @@ modm::ges::Painter<Format>::drawOddEllipse(const Ellipse &ellipse, const AlphaCo
 	int16_t y1 = y0 + ellipse.getHeight();
 
 	int32_t a = abs(x1-x0), b = abs(y1-y0), b1 = b & 1;           /* diameter */
-	int64_t dx = 4*(1.0-a)*b*b, dy = 4*(b1+1)*a*a;         /* error increment */
-	int64_t err = dx+dy+b1*a*a, e2;                        /* error of 1.step */
+	// the increments are kept halved and the error is compared to them instead of 2*err
+	Error dx = 2*(1-a)*Error(b)*b, dy = 2*(b1+1)*Error(a)*a;   /* error increment / 2 */
+	Error err = 2*dx+2*dy+b1*Error(a)*a, e;                    /* error of 1.step */
 
 	y0 += (b+1)/2; y1 = y0-b1;                              /* starting pixel */
-	a = 8*a*a; b1 = 8*b*b;
+	const Error ay = 4*Error(a)*a, bx = 4*Error(b)*b;
 
 	do
 	{
-		if (clipRect.contains(x1, y0)) surface.compositePixel(x1, y0, color, composition);	//   I. Quadrant
-		if (clipRect.contains(x0, y0)) surface.compositePixel(x0, y0, color, composition);	//  II. Quadrant
-		if (clipRect.contains(x0, y1)) surface.compositePixel(x0, y1, color, composition);	// III. Quadrant
-		if (clipRect.contains(x1, y1)) surface.compositePixel(x1, y1, color, composition);	//  IV. Quadrant
-		e2 = 2*err;
-		if (e2 <= dy) { ++y0; --y1; err += dy += a; }                 /* y step */
-		if (e2 >= dx || 2*err > dy) { ++x0; --x1; err += dx += b1; }  /* x step */
+		if (isVisible(x1, y0)) surface.compositePixel(x1, y0, color, composition);	//   I. Quadrant
+		if (isVisible(x0, y0)) surface.compositePixel(x0, y0, color, composition);	//  II. Quadrant
+		if (isVisible(x0, y1)) surface.compositePixel(x0, y1, color, composition);	// III. Quadrant
+		if (isVisible(x1, y1)) surface.compositePixel(x1, y1, color, composition);	//  IV. Quadrant
+		e = err;
+		if (e <= dy) { ++y0; --y1; dy += ay; err += dy; err += dy; }                /* y step */
+		if (e >= dx || err > dy) { ++x0; --x1; dx += bx; err += dx; err += dx; }  /* x step */
 	}
 	while (x0 <= x1);
 
@@ -524,10 +1129,10 @@ modm::ges::Painter<Format>::drawOddEllipse(const Ellipse &ellipse, const AlphaCo
 	while (y0-y1 <= b)
 	{
 		// -> finish tip of ellipse
-		if (clipRect.contains(x0-1, y0)) surface.compositePixel(x0-1, y0, color, composition);
-		if (clipRect.contains(x1+1, y0)) surface.compositePixel(x1+1, y0, color, composition);
-		if (clipRect.contains(x0-1, y1)) surface.compositePixel(x0-1, y1, color, composition);
-		if (clipRect.contains(x1+1, y1)) surface.compositePixel(x1+1, y1, color, composition);
+		if (isVisible(x0-1, y0)) surface.compositePixel(x0-1, y0, color, composition);
+		if (isVisible(x1+1, y0)) surface.compositePixel(x1+1, y0, color, composition);
+		if (isVisible(x0-1, y1)) surface.compositePixel(x0-1, y1, color, composition);
+		if (isVisible(x1+1, y1)) surface.compositePixel(x1+1, y1, color, composition);
 		++y0; --y1;
 	}
 }
@@ -536,8 +1141,10 @@ template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::fillEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition)
 {
+	const Instrument instrument(*this, Primitive::FillEllipse);
 	// we don't draw empty circles
 	if (unlikely(ellipse.isEmpty())) return;
+	instrument.damage(ellipse.getBounds());
 
 	// only draw intersecting circles
 	if (unlikely(not ellipse.intersects(clipRect))) return;
@@ -548,17 +1155,25 @@ modm::ges::Painter<Format>::fillEllipse(const Ellipse &ellipse, const AlphaColor
 		return;
 	}
 
+	const int16_t diameter = xpcc::max(int16_t(ellipse.getWidth()), int16_t(ellipse.getHeight()));
 	if (ellipse.isEven())
 	{
-		fillEvenEllipse(ellipse, color, composition);
+		if (likely(diameter <= EvenEllipseLimit))
+			fillEvenEllipse<int32_t>(ellipse, color, composition);
+		else
+			fillEvenEllipse<int64_t>(ellipse, color, composition);
 	}
 	else
 	{
-		fillOddEllipse(ellipse, color, composition);
+		if (likely(diameter <= OddEllipseLimit))
+			fillOddEllipse<int32_t>(ellipse, color, composition);
+		else
+			fillOddEllipse<int64_t>(ellipse, color, composition);
 	}
 }
 
 template< modm::ges::PixelFormat Format >
+template< typename Error >
 void
 modm::ges::Painter<Format>::fillEvenEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition)
 {
@@ -566,13 +1181,14 @@ modm::ges::Painter<Format>::fillEvenEllipse(const Ellipse &ellipse, const AlphaC
 	int16_t b = ellipse.getHeight() / 2;
 
 	int32_t x = -a, y = 0;					// II. quadrant from bottom left to top right
-	int32_t e2 = b, dx = (1+2*x)*e2*e2;	// error increment
-	int32_t dy = x*x, err = dx+dy;			// error of 1.step
+	Error e2 = b, dx = (1+2*x)*e2*e2;		// error increment
+	Error dy = Error(x)*x, err = dx+dy;		// error of 1.step
 	int16_t xm = ellipse.getX() + a;
 	int16_t ym = ellipse.getY() + b;
+	// last drawn row, every row is drawn once with its widest span
 	int16_t yPrev = 0;
 
-	drawHorizontalLineClipped(ym-y, xm+x, xm-x, color, composition);
+	drawHorizontalLineClipped(ym, xm+x, xm-x, color, composition);
 
 	do
 	{
@@ -584,21 +1200,22 @@ modm::ges::Painter<Format>::fillEvenEllipse(const Ellipse &ellipse, const AlphaC
 		}
 
 		e2 = 2*err;
-		if (e2 >= dx) { x++; err += dx += 2*int32_t(b)*b; }	// x step
-		if (e2 <= dy) { y++; err += dy += 2*int32_t(a)*a; }	// y step
+		if (e2 >= dx) { x++; err += dx += 2*Error(b)*b; }	// x step
+		if (e2 <= dy) { y++; err += dy += 2*Error(a)*a; }	// y step
 	}
 	while (x <= 0);
 
 	// too early stop for flat ellipses with a=1
-	// -> finish tip of ellipse
-	if (unlikely(y < b))
+	// -> finish tip of ellipse below the last drawn row
+	if (unlikely(yPrev < b))
 	{
-		drawVerticalLineClipped(xm, ym+y, ym+b, color, composition);
-		drawVerticalLineClipped(xm, ym-y, ym-b, color, composition);
+		drawVerticalLineClipped(xm, ym+yPrev+1, ym+b, color, composition);
+		drawVerticalLineClipped(xm, ym-b, ym-yPrev-1, color, composition);
 	}
 }
 
 template< modm::ges::PixelFormat Format >
+template< typename Error >
 void
 modm::ges::Painter<Format>::fillOddEllipse(const Ellipse &ellipse, const AlphaColor color, const CompositionOperator composition)
 {
@@ -608,11 +1225,12 @@ modm::ges::Painter<Format>::fillOddEllipse(const Ellipse &ellipse, const AlphaCo
 	int16_t y1 = y0 + ellipse.getHeight();
 
 	int32_t a = abs(x1-x0), b = abs(y1-y0), b1 = b & 1;           /* diameter */
-	int64_t dx = 4*(1.0-a)*b*b, dy = 4*(b1+1)*a*a;         /* error increment */
-	int64_t err = dx+dy+b1*a*a, e2;                        /* error of 1.step */
+	// the increments are kept halved and the error is compared to them instead of 2*err
+	Error dx = 2*(1-a)*Error(b)*b, dy = 2*(b1+1)*Error(a)*a;   /* error increment / 2 */
+	Error err = 2*dx+2*dy+b1*Error(a)*a, e;                    /* error of 1.step */
 
 	y0 += (b+1)/2; y1 = y0-b1;                              /* starting pixel */
-	a = 8*a*a; b1 = 8*b*b;
+	const Error ay = 4*Error(a)*a, bx = 4*Error(b)*b;
 
 	int16_t yPrev = y0;
 	drawHorizontalLineClipped(y0, x0, x1, color, composition);
@@ -627,23 +1245,451 @@ modm::ges::Painter<Format>::fillOddEllipse(const Ellipse &ellipse, const AlphaCo
 			yPrev = y0;
 		}
 
-		e2 = 2*err;
-		if (e2 <= dy) { ++y0; --y1; err += dy += a; }                 /* y step */
-		if (e2 >= dx || 2*err > dy) { ++x0; --x1; err += dx += b1; }  /* x step */
+		e = err;
+		if (e <= dy) { ++y0; --y1; dy += ay; err += dy; err += dy; }                /* y step */
+		if (e >= dx || err > dy) { ++x0; --x1; dx += bx; err += dx; err += dx; }  /* x step */
 	}
 	while (x0 <= x1);
 
 	// too early stop of flat ellipses a=1
-	while (y0-y1 < b)
+	while (y0-y1 <= b)
 	{
-		// -> finish tip of ellipse
+		// -> finish tip of ellipse, the last drawn row is already wider
+		if (y0 != yPrev)
+		{
+			drawHorizontalLineClipped(y0, x0-1, x1+1, color, composition);
+			drawHorizontalLineClipped(y1, x0-1, x1+1, color, composition);
+		}
 		++y0; --y1;
-		drawHorizontalLineClipped(y0, x0-1, x1+1, color, composition);
-		drawHorizontalLineClipped(y1, x0-1, x1+1, color, composition);
 	}
 }
 
 
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImage(const Surface<SourceFormat> &image, const Point &destination,
+									  const CompositionOperator composition)
+{
+	drawImageClipped<SourceFormat>(image, image.getBounds(), destination, composition, nullptr);
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImage(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+									  const CompositionOperator composition)
+{
+	drawImageClipped<SourceFormat>(image, source, destination, composition, nullptr);
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImage(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+									  const PixelColor<SourceFormat> colorKey, const CompositionOperator composition)
+{
+	drawImageClipped<SourceFormat>(image, source, destination, composition, &colorKey);
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImage(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+									  const uint8_t opacity, const CompositionOperator composition)
+{
+	drawImageClipped<SourceFormat>(image, source, destination, composition, nullptr, opacity);
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImageClipped(const Surface<SourceFormat> &image, const Rect &source, const Point &destination,
+											 const CompositionOperator composition, const PixelColor<SourceFormat> *colorKey,
+											 const uint8_t opacity)
+{
+	const Instrument instrument(*this, Primitive::Image);
+	// offset from source to destination coordinates
+	const int16_t dx = int16_t(destination.getX()) - int16_t(source.getLeft());
+	const int16_t dy = int16_t(destination.getY()) - int16_t(source.getTop());
+
+	// clip the source rectangle to the image
+	int16_t sl = xpcc::max(int16_t(source.getLeft()), int16_t(0));
+	int16_t st = xpcc::max(int16_t(source.getTop()), int16_t(0));
+	int16_t sr = xpcc::min(int16_t(source.getRight()), int16_t(image.getWidth() - 1));
+	int16_t sb = xpcc::min(int16_t(source.getBottom()), int16_t(image.getHeight() - 1));
+
+	const int32_t area = (sl <= sr and st <= sb) ? (int32_t(sr) - sl + 1) * (int32_t(sb) - st + 1) : 0;
+
+	// clip the source rectangle to the clip area at the destination
+	sl = xpcc::max(sl, int16_t(clipRect.getLeft()   - dx));
+	st = xpcc::max(st, int16_t(clipRect.getTop()    - dy));
+	sr = xpcc::min(sr, int16_t(clipRect.getRight()  - dx));
+	sb = xpcc::min(sb, int16_t(clipRect.getBottom() - dy));
+
+	if (sl > sr or st > sb)
+	{
+		countClipped(area);
+		return;
+	}
+	countClipped(area - (int32_t(sr) - sl + 1) * (int32_t(sb) - st + 1));
+	instrument.damage(Rect(Point(sl + dx, st + dy), Point(sr + dx, sb + dy)));
+
+	for (int16_t sy = st; sy <= sb; sy++)
+	{
+		forEachVisibleSpan(sy + dy, sl + dx, sr + dx, [&](int16_t y, int16_t beginX, int16_t endX)
+		{
+			const int16_t sx = beginX - dx;
+			if (likely(opacity == 0xff))
+			{
+				if (copyNativeSpan(image, sx, sy, y, beginX, endX, composition, colorKey)) return;
+				drawPixelSpan<SourceFormat>([&](int16_t ii) { return image.getPixel(sx + ii, sy); },
+											(isCopyable<SourceFormat>() and image.hasContiguousRows()) ? image.getAddress(sx, sy) : nullptr,
+											y, beginX, endX, composition, colorKey);
+			}
+			else
+			{
+				// premultiplied colors are faded by scaling all four channels, two per 32bit lane
+				const uint32_t scale = opacity + (opacity >> 7);
+				drawPixelSpan<PixelFormat::ARGB8>([&](int16_t ii)
+				{
+					const uint32_t c = PixelConversion<PixelFormat::ARGB8, SourceFormat>::convert(image.getPixel(sx + ii, sy)).getValue();
+					return Color((((c & 0xff00ff) * scale >> 8) & 0xff00ff) | (((c >> 8) & 0xff00ff) * scale & 0xff00ff00));
+				}, nullptr, y, beginX, endX, composition, nullptr);
+			}
+		});
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImage(const RleImage<SourceFormat> &image, const Point &destination,
+									  const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::RleImage);
+	using Image = RleImage<SourceFormat>;
+	using Run = typename Image::Run;
+
+	const int16_t dx = destination.getX();
+	const int16_t dy = destination.getY();
+	const int16_t top = xpcc::max(dy, int16_t(clipRect.getTop()));
+	const int16_t bottom = xpcc::min(int16_t(dy + image.getHeight() - 1), int16_t(clipRect.getBottom()));
+	const int16_t left = clipRect.getLeft();
+	const int16_t right = clipRect.getRight();
+	if (top <= bottom and dx <= right and dx + image.getWidth() - 1 >= left)
+		instrument.damage(Rect(Point(xpcc::max(dx, left), top), Point(xpcc::min(int16_t(dx + image.getWidth() - 1), right), bottom)));
+
+	const uint8_t *header = image.getData();
+	for (int16_t y = dy; y <= bottom; y++)
+	{
+		int16_t x = dx;
+		const int16_t end = dx + image.getWidth();
+		while (x < end)
+		{
+			// the runs of rows above the clip area only need to be skipped
+			const Run run = Image::getRun(*header);
+			const uint8_t length = Image::getLength(*header);
+			const int16_t beginX = xpcc::max(x, left);
+			const int16_t endX = xpcc::min(int16_t(x + length - 1), right);
+
+			if (y >= top and run != Run::Skip and beginX <= endX)
+			{
+				const uint8_t *pixels = header + 1;
+				forEachVisibleSpan(y, beginX, endX, [&](int16_t y, int16_t beginX, int16_t endX)
+				{
+					if (run == Run::Solid)
+					{
+						drawSolidSpan(Image::getPixel(pixels), y, beginX, endX, composition);
+					}
+					else
+					{
+						const uint8_t *row = pixels + (beginX - x) * sizeof(typename Image::Type);
+						drawPixelSpan<SourceFormat>([&](int16_t ii) { return Image::getPixel(row + ii * sizeof(typename Image::Type)); },
+													row, y, beginX, endX, composition, nullptr);
+					}
+				});
+			}
+
+			header = Image::skipRun(header);
+			x += length;
+		}
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImageScaled(const Surface<SourceFormat> &image, const Point &destination, const uint8_t factor)
+{
+	const Instrument instrument(*this, Primitive::ImageScaled);
+	if (factor == 0) return;
+
+	const int16_t dx = destination.getX();
+	const int16_t dy = destination.getY();
+	const int16_t left   = std::max<int32_t>(dx, int16_t(clipRect.getLeft()));
+	const int16_t right  = std::min<int32_t>(dx + int32_t(image.getWidth()) * factor - 1, int16_t(clipRect.getRight()));
+	const int16_t top    = std::max<int32_t>(dy, int16_t(clipRect.getTop()));
+	const int16_t bottom = std::min<int32_t>(dy + int32_t(image.getHeight()) * factor - 1, int16_t(clipRect.getBottom()));
+	if (left > right or top > bottom) return;
+	instrument.damage(Rect(Point(left, top), Point(right, bottom)));
+
+	for (int16_t y = top; y <= bottom; )
+	{
+		const int16_t sy = (y - dy) / factor;
+		const int16_t last = std::min<int32_t>(dy + (sy + 1) * factor - 1, bottom);
+
+		// the first row is expanded once, then copied for all other rows
+		auto expand = [&](int16_t y, int16_t beginX, int16_t endX)
+		{
+			drawScaledSpan(image, sy, dx, factor, y, beginX, endX);
+		};
+		forEachVisibleSpan(y, left, right, expand);
+
+		for (int16_t yy = y + 1; yy <= last; yy++)
+		{
+			if (isCopyable<Format>() and surface.hasContiguousRows() and clipRegion == nullptr)
+			{
+				std::memcpy(surface.getAddress(left, yy), surface.getAddress(left, y),
+							(right - left + 1) * sizeof(*surface.buffer));
+				countSpan(left, right);
+			}
+			else forEachVisibleSpan(yy, left, right, expand);
+		}
+		y = last + 1;
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawScaledSpan(const Surface<SourceFormat> &image, int16_t sy, int16_t dx, uint8_t factor,
+										   int16_t y, int16_t beginX, int16_t endX)
+{
+	for (int16_t x = beginX; x <= endX; )
+	{
+		const int16_t sx = (x - dx) / factor;
+		const NativeColor color = PixelConversion<Format, SourceFormat>::convert(image.getPixel(sx, sy));
+		const int16_t end = std::min<int32_t>(dx + (sx + 1) * factor - 1, endX);
+
+		surface.fillSpan(y, x, end, color);
+		x = end + 1;
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawImage(const Surface<SourceFormat> &image, const Transform &transform,
+									  const Sampling sampling, const CompositionOperator composition)
+{
+	const Instrument instrument(*this, Primitive::ImageTransformed);
+	using value_t = Transform::value_t;
+	constexpr int32_t One = int32_t(1) << value_t::Fractions;
+
+	if (not transform.isInvertible() or image.getWidth() == 0 or image.getHeight() == 0) return;
+
+	auto floorDiv = [](int64_t a, int64_t b) -> int64_t { return (a >= 0) ? a / b : -((-a + b - 1) / b); };
+	auto ceilDiv  = [](int64_t a, int64_t b) -> int64_t { return (a >= 0) ? (a + b - 1) / b : -((-a) / b); };
+
+	// bounding box of the transformed image corners in the clip area
+	const value_t width = image.getWidth();
+	const value_t height = image.getHeight();
+	const value_t xs[4] = {transform.mapX(0, 0), transform.mapX(width, 0), transform.mapX(0, height), transform.mapX(width, height)};
+	const value_t ys[4] = {transform.mapY(0, 0), transform.mapY(width, 0), transform.mapY(0, height), transform.mapY(width, height)};
+	const int32_t minX = std::min(std::min(xs[0].value(), xs[1].value()), std::min(xs[2].value(), xs[3].value()));
+	const int32_t maxX = std::max(std::max(xs[0].value(), xs[1].value()), std::max(xs[2].value(), xs[3].value()));
+	const int32_t minY = std::min(std::min(ys[0].value(), ys[1].value()), std::min(ys[2].value(), ys[3].value()));
+	const int32_t maxY = std::max(std::max(ys[0].value(), ys[1].value()), std::max(ys[2].value(), ys[3].value()));
+
+	const int16_t left   = std::max<int32_t>(floorDiv(minX, One), int16_t(clipRect.getLeft()));
+	const int16_t right  = std::min<int32_t>(ceilDiv(maxX, One) - 1, int16_t(clipRect.getRight()));
+	const int16_t top    = std::max<int32_t>(floorDiv(minY, One), int16_t(clipRect.getTop()));
+	const int16_t bottom = std::min<int32_t>(ceilDiv(maxY, One) - 1, int16_t(clipRect.getBottom()));
+	if (left > right or top > bottom) return;
+	instrument.damage(Rect(Point(left, top), Point(right, bottom)));
+
+	// the source coordinates of the pixel centers only increase by a constant per pixel
+	const Transform inverse = transform.inverted();
+	const int32_t du = inverse.a.value();
+	const int32_t dv = inverse.d.value();
+	const int64_t centerX = int64_t(left) * One + One / 2;
+	const int64_t limitU = int64_t(image.getWidth()) * One - 1;
+	const int64_t limitV = int64_t(image.getHeight()) * One - 1;
+
+	// narrows [begin, end] so that `p + dp * k` stays within [0, limit]
+	auto constrain = [&](int64_t p, int32_t dp, int64_t limit, int64_t &begin, int64_t &end)
+	{
+		if (dp > 0) {
+			begin = std::max(begin, ceilDiv(-p, dp));
+			end = std::min(end, floorDiv(limit - p, dp));
+		}
+		else if (dp < 0) {
+			begin = std::max(begin, ceilDiv(p - limit, -dp));
+			end = std::min(end, floorDiv(p, -dp));
+		}
+		else if (p < 0 or p > limit) end = begin - 1;
+	};
+
+	for (int16_t y = top; y <= bottom; y++)
+	{
+		const int64_t centerY = int64_t(y) * One + One / 2;
+		const int32_t u0 = floorDiv(inverse.a.value() * centerX + inverse.b.value() * centerY, One) + inverse.c.value();
+		const int32_t v0 = floorDiv(inverse.d.value() * centerX + inverse.e.value() * centerY, One) + inverse.f.value();
+
+		// only the pixels mapping into the image are evaluated
+		int64_t begin = 0, end = right - left;
+		constrain(u0, du, limitU, begin, end);
+		constrain(v0, dv, limitV, begin, end);
+		if (begin > end) continue;
+
+		forEachVisibleSpan(y, left + begin, left + end, [&](int16_t y, int16_t beginX, int16_t endX)
+		{
+			int32_t u = u0 + du * (beginX - left);
+			int32_t v = v0 + dv * (beginX - left);
+			for (int16_t x = beginX; x <= endX; x++, u += du, v += dv)
+			{
+				const AlphaColor color = (sampling == Sampling::Bilinear) ?
+						sampleBilinear(image, u, v) :
+						PixelConversion<AlphaColor::Format, SourceFormat>::convert(image.getPixel(u / One, v / One));
+				surface.compositePixel(x, y, color, composition);
+			}
+		});
+	}
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+typename modm::ges::Painter<Format>::AlphaColor
+modm::ges::Painter<Format>::sampleBilinear(const Surface<SourceFormat> &image, int32_t u, int32_t v)
+{
+	constexpr int32_t One = int32_t(1) << Transform::value_t::Fractions;
+	using Conversion = PixelConversion<PixelFormat::ARGB8, SourceFormat>;
+
+	// interpolate between the centers of the four closest pixels
+	u -= One / 2;
+	v -= One / 2;
+	const int16_t x0 = std::max<int32_t>(u, 0) / One;
+	const int16_t y0 = std::max<int32_t>(v, 0) / One;
+	const int16_t x1 = std::min<int16_t>(x0 + (u >= 0), image.getWidth() - 1);
+	const int16_t y1 = std::min<int16_t>(y0 + (v >= 0), image.getHeight() - 1);
+	const uint32_t fx = (u >= 0) ? (u % One) * 256 / One : 0;
+	const uint32_t fy = (v >= 0) ? (v % One) * 256 / One : 0;
+
+	// blends all four channels at once, two per 32bit lane
+	auto lerp = [](uint32_t c0, uint32_t c1, uint32_t w) -> uint32_t
+	{
+		const uint32_t rb = ((((c0 & 0xff00ff) * (256 - w)) + ((c1 & 0xff00ff) * w)) >> 8) & 0xff00ff;
+		const uint32_t ag = ((((c0 >> 8) & 0xff00ff) * (256 - w)) + (((c1 >> 8) & 0xff00ff) * w)) & 0xff00ff00;
+		return rb | ag;
+	};
+
+	const uint32_t top = lerp(Conversion::convert(image.getPixel(x0, y0)).getValue(),
+							  Conversion::convert(image.getPixel(x1, y0)).getValue(), fx);
+	const uint32_t bottom = lerp(Conversion::convert(image.getPixel(x0, y1)).getValue(),
+								 Conversion::convert(image.getPixel(x1, y1)).getValue(), fx);
+
+	return PixelConversion<AlphaColor::Format, PixelFormat::ARGB8>::convert(Color(lerp(top, bottom, fy)));
+}
+
+template< modm::ges::PixelFormat Format >
+bool
+modm::ges::Painter<Format>::copyNativeSpan(const NativeSurface &image, int16_t sx, int16_t sy, int16_t y, int16_t beginX, int16_t endX,
+										   const CompositionOperator composition, const NativeColor *colorKey)
+{
+	constexpr bool hasAlpha = std::is_same<NativeColor, AlphaColor>::value;
+	if (colorKey != nullptr) return false;
+	if (not (composition == A or (composition == AoverB and not hasAlpha))) return false;
+
+	surface.copySpan(y, beginX, image, sx, sy, endX - beginX + 1);
+	return true;
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat, typename Function >
+void
+modm::ges::Painter<Format>::drawPixelSpan(Function &&pixelAt, const void *pixels, int16_t y, int16_t beginX, int16_t endX,
+										  const CompositionOperator composition, const PixelColor<SourceFormat> *colorKey)
+{
+	using SourceColor = PixelColor<SourceFormat>;
+	using Conversion = PixelConversion<AlphaColor::Format, SourceFormat>;
+
+	constexpr bool hasAlpha = std::is_same<SourceColor, typename SourceColor::AlphaColor>::value;
+	const auto opaque = getOpaqueAlpha();
+
+	// A over B is just A for opaque source pixels
+	const bool isOver = (composition == AoverB);
+	const bool isCopy = (composition == A) or (isOver and not hasAlpha);
+
+	// collects opaque pixels into one run, which is then copied at once
+	const bool canCopy = (pixels != nullptr) and surface.hasContiguousRows();
+	int16_t copyBegin = 0;
+	int16_t copyLength = 0;
+	auto copy = [&]()
+	{
+		std::memcpy(surface.getAddress(beginX + copyBegin, y),
+					static_cast<const uint8_t*>(pixels) + copyBegin * sizeof(*surface.buffer),
+					copyLength * sizeof(*surface.buffer));
+		copyLength = 0;
+	};
+
+	for (int16_t ii = 0; ii <= endX - beginX; ii++)
+	{
+		const SourceColor pixel = pixelAt(ii);
+		const AlphaColor color = Conversion::convert(pixel);
+
+		bool visible = (colorKey == nullptr or not (pixel == *colorKey));
+		bool isOpaque = isCopy;
+		if (hasAlpha and isOver)
+		{
+			// transparent pixels do not change premultiplied destinations
+			visible = visible and (color.getAlpha() != 0);
+			isOpaque = (color.getAlpha() == opaque);
+		}
+
+		if (isCopyable<SourceFormat>() and visible and isOpaque)
+		{
+			if (not canCopy)
+			{
+				surface.setPixel(beginX + ii, y, NativeColor(pixel.getValue()));
+				continue;
+			}
+			if (copyLength == 0) copyBegin = ii;
+			copyLength++;
+			continue;
+		}
+		if (copyLength) copy();
+
+		if (visible) surface.compositePixel(beginX + ii, y, color, isOpaque ? A : composition);
+	}
+	if (copyLength) copy();
+}
+
+template< modm::ges::PixelFormat Format >
+template< modm::ges::PixelFormat SourceFormat >
+void
+modm::ges::Painter<Format>::drawSolidSpan(const PixelColor<SourceFormat> pixel, int16_t y, int16_t beginX, int16_t endX,
+										  const CompositionOperator composition)
+{
+	using SourceColor = PixelColor<SourceFormat>;
+	constexpr bool hasAlpha = std::is_same<SourceColor, typename SourceColor::AlphaColor>::value;
+
+	const AlphaColor color = PixelConversion<AlphaColor::Format, SourceFormat>::convert(pixel);
+	const bool isOver = (composition == AoverB);
+	const bool isOpaque = (composition == A) or
+			(isOver and (not hasAlpha or color.getAlpha() == getOpaqueAlpha()));
+
+	if (isOver and color.getAlpha() == 0) return;
+
+	if (isCopyable<SourceFormat>() and isOpaque)
+	{
+		surface.fillSpan(y, beginX, endX, NativeColor(pixel.getValue()));
+		return;
+	}
+	drawHorizontalSpan(y, beginX, endX, color, isOpaque ? A : composition);
+}
+
+
 template< modm::ges::PixelFormat Format >
 void
 modm::ges::Painter<Format>::drawHorizontalLineClipped(int16_t y, int16_t beginX, int16_t endX,
@@ -656,9 +1702,13 @@ modm::ges::Painter<Format>::drawHorizontalLineClipped(int16_t y, int16_t beginX,
 		if (likely(beginX <= cR))
 		{
 			// line starts before right of clip window
-			drawHorizontalLine(y, std::max(beginX, int16_t(clipRect.getLeft())), std::min(endX, cR), color, composition);
+			const int16_t bX = std::max(beginX, int16_t(clipRect.getLeft())), eX = std::min(endX, cR);
+			countClipped(int32_t(endX - beginX) - std::max(eX - bX, -1));
+			drawHorizontalLine(y, bX, eX, color, composition);
+			return;
 		}
 	}
+	countClipped(int32_t(endX - beginX) + 1);
 }
 
 template< modm::ges::PixelFormat Format >
@@ -673,9 +1723,13 @@ modm::ges::Painter<Format>::drawVerticalLineClipped(int16_t x, int16_t beginY, i
 		if (likely(beginY <= cB))
 		{
 			// line starts before right of clip window
-			drawVerticalLine(x, std::max(beginY, int16_t(clipRect.getTop())), std::min(endY, cB), color, composition);
+			const int16_t bY = std::max(beginY, int16_t(clipRect.getTop())), eY = std::min(endY, cB);
+			countClipped(int32_t(endY - beginY) - std::max(eY - bY, -1));
+			drawVerticalLine(x, bY, eY, color, composition);
+			return;
 		}
 	}
+	countClipped(int32_t(endY - beginY) + 1);
 }
 
 
@@ -684,20 +1738,126 @@ void
 modm::ges::Painter<Format>::drawHorizontalLine(int16_t y, int16_t beginX, int16_t endX,
 				   const AlphaColor color, const CompositionOperator composition)
 {
+	forEachVisibleSpan(y, beginX, endX, [&](int16_t y, int16_t beginX, int16_t endX)
+	{
+		drawHorizontalSpan(y, beginX, endX, color, composition);
+	});
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawVerticalLine(int16_t x, int16_t beginY, int16_t endY,
+				 const AlphaColor color, const CompositionOperator composition)
+{
+	if (likely(clipRegion == nullptr))
+	{
+		countSpan(beginY, endY);
+		drawVerticalSpan(x, beginY, endY, color, composition);
+		return;
+	}
+
+	// walk down the bands from the first one overlapping this column
+	int32_t clipped = int32_t(endY - beginY) + 1;
+	uint8_t end;
+	uint8_t ii = clipRegion->findBand(beginY, end);
+	while (ii < clipRegion->count and clipRegion->boxes[ii].top <= endY)
+	{
+		end = clipRegion->getBandEnd(ii);
+		for (; ii < end; ii++)
+		{
+			const Region::Box &box = clipRegion->boxes[ii];
+			if (box.left > x) break;
+			if (box.right < x) continue;
+			const int16_t bY = std::max(beginY, box.top), eY = std::min(endY, box.bottom);
+			countSpan(bY, eY);
+			clipped -= std::max(eY - bY + 1, 0);
+			drawVerticalSpan(x, bY, eY, color, composition);
+			break;
+		}
+		ii = end;
+	}
+	countClipped(clipped);
+}
+
+
+template< modm::ges::PixelFormat Format >
+template< typename Function >
+void
+modm::ges::Painter<Format>::forEachVisibleSpan(int16_t y, int16_t beginX, int16_t endX, Function &&function)
+{
+	if (likely(clipRegion == nullptr))
+	{
+		countSpan(beginX, endX);
+		function(y, beginX, endX);
+		return;
+	}
+
+	// only the band containing this row needs to be searched
+	int32_t clipped = int32_t(endX - beginX) + 1;
+	uint8_t end;
+	for (uint8_t ii = clipRegion->findBand(y, end); ii < end; ii++)
+	{
+		const Region::Box &box = clipRegion->boxes[ii];
+		if (box.left > endX) break;
+		if (box.right < beginX) continue;
+		const int16_t bX = std::max(beginX, box.left), eX = std::min(endX, box.right);
+		countSpan(bX, eX);
+		clipped -= eX - bX + 1;
+		function(y, bX, eX);
+	}
+	countClipped(clipped);
+}
+
+template< modm::ges::PixelFormat Format >
+void
+modm::ges::Painter<Format>::drawHorizontalSpan(int16_t y, int16_t beginX, int16_t endX,
+				   const AlphaColor color, const CompositionOperator composition)
+{
+	if (unlikely(beginX > endX)) return;
+
+	if (isFill(color, composition))
+	{
+		NativeColor pixel;
+		(pixel.*composition)(color);
+		surface.fillSpan(y, beginX, endX, pixel);
+#ifdef MODM_GES_DEBUG_OVERDRAW
+		for (int16_t xx = beginX; xx <= endX; xx++) countWrite(xx, y);
+#endif
+		return;
+	}
+
 	for (int16_t xx = beginX; xx <= endX; xx++)
 	{
 		surface.compositePixel(xx, y, color, composition);
+#ifdef MODM_GES_DEBUG_OVERDRAW
+		countWrite(xx, y);
+#endif
 	}
 }
 
 template< modm::ges::PixelFormat Format >
 void
-modm::ges::Painter<Format>::drawVerticalLine(int16_t x, int16_t beginY, int16_t endY,
+modm::ges::Painter<Format>::drawVerticalSpan(int16_t x, int16_t beginY, int16_t endY,
 				 const AlphaColor color, const CompositionOperator composition)
 {
+	if (unlikely(beginY > endY)) return;
+
+	if (isFill(color, composition))
+	{
+		NativeColor pixel;
+		(pixel.*composition)(color);
+		surface.fillColumn(x, beginY, endY, pixel);
+#ifdef MODM_GES_DEBUG_OVERDRAW
+		for (int16_t yy = beginY; yy <= endY; yy++) countWrite(x, yy);
+#endif
+		return;
+	}
+
 	for (int16_t yy = beginY; yy <= endY; yy++)
 	{
 		surface.compositePixel(x, yy, color, composition);
+#ifdef MODM_GES_DEBUG_OVERDRAW
+		countWrite(x, yy);
+#endif
 	}
 }
-
@@ -0,0 +1,101 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_PAINTER_STATISTICS_HPP
+#define MODM_GES_PAINTER_STATISTICS_HPP
+
+#include <stdint.h>
+
+namespace modm
+{
+
+namespace ges
+{
+
+enum class
+Primitive : uint8_t
+{
+	Points,
+	Line,
+	Polyline,
+	Rect,
+	FillRect,
+	RoundedRect,
+	FillRoundedRect,
+	Circle,
+	FillCircle,
+	Arc,
+	Pie,
+	Ring,
+	Ellipse,
+	FillEllipse,
+	Image,
+	ImageScaled,
+	ImageTransformed,
+	RleImage,
+	Count,
+};
+
+// Counters of the painter per primitive, which are only collected if
+// `MODM_GES_STATISTICS` is defined. Primitives called by other primitives
+// are accounted to the outermost one.
+struct PainterStatistics
+{
+	struct Counters
+	{
+		uint32_t calls;
+		uint32_t pixels;	// in spans and single pixels given to the surface
+		uint32_t clipped;	// rejected by the clip area or region
+		uint32_t spans;
+		uint32_t time;		// in units of the clock
+	};
+
+	Counters primitives[uint8_t(Primitive::Count)] = {};
+
+	inline Counters &
+	operator [] (Primitive primitive)
+	{ return primitives[uint8_t(primitive)]; }
+
+	inline const Counters &
+	operator [] (Primitive primitive) const
+	{ return primitives[uint8_t(primitive)]; }
+
+	// usually at the start of every frame
+	inline void
+	reset()
+	{ *this = PainterStatistics(); }
+
+	static inline const char *
+	getName(Primitive primitive)
+	{
+		static constexpr const char *names[uint8_t(Primitive::Count)] = {
+			"Points", "Line", "Polyline", "Rect", "FillRect", "RoundedRect", "FillRoundedRect",
+			"Circle", "FillCircle", "Arc", "Pie", "Ring", "Ellipse", "FillEllipse",
+			"Image", "ImageScaled", "ImageTransformed", "RleImage" };
+		return (primitive < Primitive::Count) ? names[uint8_t(primitive)] : "";
+	}
+
+	// writes one line per called primitive into any stream with `operator <<`
+	template< typename Stream >
+	void
+	dump(Stream &stream) const
+	{
+		for (uint8_t ii = 0; ii < uint8_t(Primitive::Count); ii++)
+		{
+			const Counters &c = primitives[ii];
+			if (c.calls == 0) continue;
+			stream << getName(Primitive(ii)) << ": calls=" << c.calls << " pixels=" << c.pixels
+				   << " clipped=" << c.clipped << " spans=" << c.spans << " time=" << c.time << "\n";
+		}
+	}
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_PAINTER_STATISTICS_HPP
@@ -24,10 +24,8 @@ namespace ges
 template< uint16_t Width, uint16_t Height, PixelFormat Format >
 class PixelBuffer
 {
-	static_assert((Format != PixelFormat::L1) or (Width % 8 == 0),
-				  "Pixel buffer width must be a multiple of 8!");
-	static_assert((Format != PixelFormat::L4) or (Width % 2 == 0),
-				  "Pixel buffer width must be a multiple of 2!");
+	static_assert((Width * PixelColor<Format>::Bits) % 8 == 0,
+				  "Pixel buffer rows must be a multiple of 8 bits!");
 public:
 	PixelBuffer() : data{0} {}
 
@@ -63,8 +61,14 @@ public:
 	getLength()
 	{ return Width * Height * PixelColor<Format>::Bits / 8; }
 
+	// one bit surfaces may be organized in pages of 8 rows, so their
+	// buffers are rounded up to whole pages
+	static constexpr std::size_t
+	getCapacity()
+	{ return (PixelColor<Format>::Bits == 1) ? Width * ((Height + 7) / 8) : getLength(); }
+
 private:
-	uint8_t data[getLength()] ATTRIBUTE_ALIGNED(4);
+	uint8_t data[getCapacity()] ATTRIBUTE_ALIGNED(4);
 };
 
 } // namespace ges
@@ -198,6 +198,7 @@ using Color = ColorARGB8;
 
 } // namespace modm
 
+#include "pixel_color/palette.hpp"
 #include "pixel_color/pixel_color_l1.hpp"
 #include "pixel_color/pixel_color_l2.hpp"
 #include "pixel_color/pixel_color_l4.hpp"
@@ -207,6 +208,35 @@ using Color = ColorARGB8;
 #include "pixel_color/pixel_color_rgb332.hpp"
 #include "pixel_color/pixel_color_rgb565.hpp"
 #include "pixel_color/pixel_color_rgb8.hpp"
+#include "pixel_color/pixel_color_i4.hpp"
+#include "pixel_color/pixel_color_i8.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+// converts colors of any two formats via the ARGB8 color
+template< PixelFormat To, PixelFormat From >
+struct PixelConversion
+{
+	static constexpr PixelColor<To>
+	convert(const PixelColor<From> color)
+	{ return PixelColor<To>(static_cast<Color>(color)); }
+};
+
+template< PixelFormat Format >
+struct PixelConversion<Format, Format>
+{
+	static constexpr PixelColor<Format>
+	convert(const PixelColor<Format> color)
+	{ return color; }
+};
+
+} // namespace ges
+
+} // namespace modm
 
 #endif // MODM_GES_PIXEL_COLOR_HPP
 
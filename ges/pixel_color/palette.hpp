@@ -0,0 +1,208 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_PIXEL_COLOR_HPP
+#	error	"Don't include this file directly, use 'pixel_color.hpp' instead!"
+#endif
+
+#include <stdint.h>
+#include <cstddef>
+#include <xpcc/math/utils/misc.hpp>
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Opaque colors of the indexed pixel formats.
+// Blending two indices is a lookup in a precomputed table of `levels` mixes
+// for every pair of indices, the weight of the first index is rounded to
+// the nearest level. Without a table the weight is rounded to one of
+// `FallbackLevels` levels and the mix is searched in the palette, which costs
+// one distance per palette color. The last mixes and sums are cached, since
+// a primitive usually blends the same pairs again and again, but blending
+// with a table is recommended for large palettes.
+class Palette
+{
+public:
+	static constexpr uint8_t FallbackLevels = 15;
+
+	// the table holds `getBlendTableSize(count, levels)` indices and must stay valid
+	Palette(const Color *colors, uint16_t count, const uint8_t *blend = nullptr, uint8_t levels = 0) :
+		colors(colors), blend(levels ? blend : nullptr), count(count),
+		steps(blend and levels ? levels + 1 : FallbackLevels + 1), black(find(colors, count, 0, 0, 0))
+	{}
+
+	inline uint16_t
+	getCount() const
+	{ return count; }
+
+	inline Color
+	getColor(uint8_t index) const
+	{ return colors[index]; }
+
+	inline uint8_t
+	getBlack() const
+	{ return black; }
+
+	// index of the palette color closest to the opaque color
+	inline uint8_t
+	find(const Color color) const
+	{ return find(colors, count, color.getRed(), color.getGreen(), color.getBlue()); }
+
+	// index closest to a * weight / 255 + b * (255 - weight) / 255
+	inline uint8_t
+	mix(uint8_t a, uint8_t b, uint8_t weight) const
+	{
+		const uint16_t level = (uint16_t(weight) * steps * 2 + 255) / 510;
+		if (level == 0 or a == b) return b;
+		if (level >= steps) return a;
+		if (blend) return blend[(uint32_t(level - 1) * count + a) * count + b];
+
+		Cached &cached = lookup(a, b, level);
+		if (not cached.isValid())
+			cached.set(a, b, level, find(colors, count, mix(colors[a], colors[b], level, steps)));
+		return cached.index;
+	}
+
+	// index closest to the saturated sum of both colors
+	inline uint8_t
+	add(uint8_t a, uint8_t b) const
+	{
+		// sums are cached as level 0, which is never a mix
+		Cached &cached = lookup(a, b, 0);
+		if (not cached.isValid())
+		{
+			const Color ca = colors[a], cb = colors[b];
+			cached.set(a, b, 0, find(colors, count, uint8_t(xpcc::min(ca.getRed()   + cb.getRed(),   255)),
+													uint8_t(xpcc::min(ca.getGreen() + cb.getGreen(), 255)),
+													uint8_t(xpcc::min(ca.getBlue()  + cb.getBlue(),  255))));
+		}
+		return cached.index;
+	}
+
+	// Porter and Duff's compositing of colors with straight alpha, returns the
+	// index of the result and its alpha in `alpha`
+	inline uint8_t
+	compose(uint8_t a, uint8_t alphaA, uint8_t fa, uint8_t b, uint8_t alphaB, uint8_t fb, uint8_t &alpha) const
+	{
+		const uint32_t weightA = uint32_t(alphaA) * fa;
+		const uint32_t sum = weightA + uint32_t(alphaB) * fb;
+		if (sum == 0) { alpha = 0; return 0; }
+		alpha = (sum >= 255*255) ? 255 : sum / 255;
+		return mix(a, b, (weightA * 255 + sum / 2) / sum);
+	}
+
+	// index of the color with alpha premultiplied, i.e. shown on black
+	inline uint8_t
+	flatten(uint8_t index, uint8_t alpha) const
+	{ return mix(index, black, alpha); }
+
+
+	static constexpr std::size_t
+	getBlendTableSize(uint16_t count, uint8_t levels)
+	{ return std::size_t(levels) * count * count; }
+
+	// Fills the table with the mixes for `levels` evenly spaced weights,
+	// e.g. on the host to link the table into flash.
+	static void
+	computeBlendTable(const Color *colors, uint16_t count, uint8_t levels, uint8_t *table)
+	{
+		for (uint16_t level = 1; level <= levels; level++)
+			for (uint16_t a = 0; a < count; a++)
+				for (uint16_t b = 0; b < count; b++)
+					*table++ = find(colors, count, mix(colors[a], colors[b], level, levels + 1));
+	}
+
+protected:
+	static constexpr uint8_t CacheSize = 16;
+
+	struct Cached
+	{
+		uint32_t key;	// zero if empty
+		uint8_t index;
+
+		inline bool
+		isValid() const
+		{ return key != 0; }
+
+		inline void
+		set(uint8_t a, uint8_t b, uint8_t level, uint8_t result)
+		{ key = getKey(a, b, level); index = result; }
+
+		static inline uint32_t
+		getKey(uint8_t a, uint8_t b, uint8_t level)
+		{ return (1ul << 24) | (uint32_t(level) << 16) | (uint16_t(a) << 8) | b; }
+	};
+
+	// direct mapped, a miss simply replaces the entry
+	inline Cached &
+	lookup(uint8_t a, uint8_t b, uint8_t level) const
+	{
+		Cached &cached = cache[(a * 5 + b * 3 + level) & (CacheSize - 1)];
+		if (cached.key != Cached::getKey(a, b, level)) cached.key = 0;
+		return cached;
+	}
+
+	static inline Color
+	mix(const Color a, const Color b, uint16_t level, uint16_t steps)
+	{
+		const uint16_t rest = steps - level;
+		return Color(uint8_t((a.getRed()   * level + b.getRed()   * rest + steps / 2) / steps),
+					 uint8_t((a.getGreen() * level + b.getGreen() * rest + steps / 2) / steps),
+					 uint8_t((a.getBlue()  * level + b.getBlue()  * rest + steps / 2) / steps));
+	}
+
+	static inline uint8_t
+	find(const Color *colors, uint16_t count, const Color color)
+	{ return find(colors, count, color.getRed(), color.getGreen(), color.getBlue()); }
+
+	static uint8_t
+	find(const Color *colors, uint16_t count, uint8_t red, uint8_t green, uint8_t blue)
+	{
+		uint8_t best = 0;
+		uint32_t bestDistance = UINT32_MAX;
+		for (uint16_t ii = 0; ii < count; ii++)
+		{
+			const int32_t dr = int32_t(colors[ii].getRed()) - red;
+			const int32_t dg = int32_t(colors[ii].getGreen()) - green;
+			const int32_t db = int32_t(colors[ii].getBlue()) - blue;
+			const uint32_t distance = dr * dr + dg * dg + db * db;
+			if (distance < bestDistance)
+			{
+				if (distance == 0) return ii;
+				bestDistance = distance;
+				best = ii;
+			}
+		}
+		return best;
+	}
+
+private:
+	const Color *const colors;
+	const uint8_t *const blend;
+	const uint16_t count;
+	const uint16_t steps;
+	const uint8_t black;
+	mutable Cached cache[CacheSize] = {};
+};
+
+// The palette of all indexed colors with `Depth` bits. There is one palette per
+// depth, like the single color table of a display controller.
+template< uint8_t Depth >
+struct ActivePalette
+{
+	static const Palette *palette;
+};
+
+template< uint8_t Depth >
+const Palette *ActivePalette<Depth>::palette = nullptr;
+
+} // namespace ges
+
+} // namespace modm
@@ -0,0 +1,342 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_PIXEL_COLOR_HPP
+#	error	"Don't include this file directly, use 'pixel_color.hpp' instead!"
+#endif
+
+#include <stdint.h>
+#include "../pixel_format.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+
+// Index into the palette of up to 16 colors with straight alpha.
+// The palette must be set before any color is converted or composed.
+template<>
+class PixelColor<PixelFormat::AI4>
+{
+	using ThisColor = PixelColor<PixelFormat::AI4>;
+public:
+	using Type = uint8_t;
+	using AlphaColor = ThisColor;
+	static constexpr uint8_t Depth = 4;
+	static constexpr uint8_t Bits = 8;
+	static constexpr PixelFormat Format = PixelFormat::AI4;
+
+	constexpr
+	PixelColor() = default;
+
+	constexpr
+	PixelColor(const PixelColor &) = default;
+
+	explicit constexpr
+	PixelColor(const Type value) :
+		value(value) {}
+
+	constexpr
+	PixelColor(const Type index, const Type alpha) :
+		value(((alpha & 0xf) << 4) | (index & 0xf)) {}
+
+	PixelColor(const Color color) :
+		value((getPalette() ? getPalette()->find(Color(unpremultiply(color.getRed(), color.getAlpha()),
+													   unpremultiply(color.getGreen(), color.getAlpha()),
+													   unpremultiply(color.getBlue(), color.getAlpha()))) : 0) |
+			  (color.getAlpha() & 0xf0)) {}
+
+	constexpr Type
+	getValue() const
+	{ return value; }
+
+	constexpr Type
+	getIndex() const
+	{ return value & 0xf; }
+
+	constexpr Type
+	getAlpha() const
+	{ return (value & 0xf0) >> 4; }
+
+	explicit
+	operator Color() const
+	{
+		if (getPalette() == nullptr) return Color();
+		const Color color = getPalette()->getColor(value & 0xf);
+		return Color(color.getRed(), color.getGreen(), color.getBlue(), getAlpha() * 0x11);
+	}
+
+	constexpr bool
+	operator== (const ThisColor other) const
+	{ return value == other.value; }
+
+
+	// the palette is shared with `ColorI4`
+	static inline void
+	setPalette(const Palette &palette)
+	{ ActivePalette<Depth>::palette = &palette; }
+
+	static inline const Palette *
+	getPalette()
+	{ return ActivePalette<Depth>::palette; }
+
+
+	// Porter and Duff's compositing operations
+	void
+	Clear(const ThisColor)
+	{ value = 0; }
+
+
+	void
+	A(const ThisColor a)
+	{ value = a.value; }
+
+	void
+	B(const ThisColor)
+	{ }
+
+
+	void
+	AoverB(const ThisColor a)
+	{ compose(a, 15, 15 - a.getAlpha()); }
+
+	void
+	BoverA(const ThisColor a)
+	{ compose(a, 15 - getAlpha(), 15); }
+
+
+	void
+	AinB(const ThisColor a)
+	{ compose(a, getAlpha(), 0); }
+
+	void
+	BinA(const ThisColor a)
+	{ compose(a, 0, a.getAlpha()); }
+
+
+	void
+	AoutB(const ThisColor a)
+	{ compose(a, 15 - getAlpha(), 0); }
+
+	void
+	BoutA(const ThisColor a)
+	{ compose(a, 0, 15 - a.getAlpha()); }
+
+
+	void
+	AatopB(const ThisColor a)
+	{ compose(a, getAlpha(), 15 - a.getAlpha()); }
+
+	void
+	BatopA(const ThisColor a)
+	{ compose(a, 15 - getAlpha(), a.getAlpha()); }
+
+
+	void
+	Xor(const ThisColor a)
+	{ compose(a, 15 - getAlpha(), 15 - a.getAlpha()); }
+
+
+	void
+	Plus(const ThisColor a)
+	{ compose(a, 15, 15); }
+
+protected:
+	// see Porter and Duff's "Compositing Digital Images", the colors are mixed
+	// by the blend table of the palette
+	void
+	compose(const ThisColor cA, const uint8_t fa, const uint8_t fb)
+	{
+		uint8_t alpha;
+		const uint8_t index = getPalette()->compose(cA.getIndex(), cA.getAlpha() * 0x11, fa * 0x11,
+													getIndex(), getAlpha() * 0x11, fb * 0x11, alpha);
+		value = (((alpha + 8) / 17) << 4) | index;
+	}
+
+	static constexpr uint8_t
+	unpremultiply(const uint8_t channel, const uint8_t alpha)
+	{ return alpha ? ((channel >= alpha) ? 255 : uint8_t(uint16_t(channel) * 255 / alpha)) : 0; }
+
+private:
+	Type value{0};
+
+	friend
+	class PixelColor<PixelFormat::I4>;
+};
+
+using ColorAI4 = PixelColor<PixelFormat::AI4>;
+
+
+// Opaque index into the palette of up to 16 colors.
+template<>
+class PixelColor<PixelFormat::I4>
+{
+	using ThisColor = PixelColor<PixelFormat::I4>;
+public:
+	using Type = uint8_t;
+	using AlphaColor = PixelColor<PixelFormat::AI4>;
+	static constexpr uint8_t Depth = 4;
+	static constexpr uint8_t Bits = 4;
+	static constexpr PixelFormat Format = PixelFormat::I4;
+
+	constexpr
+	PixelColor() = default;
+
+	constexpr
+	PixelColor(const PixelColor &) = default;
+
+	explicit constexpr
+	PixelColor(const Type index) :
+		value(index & 0xf) {}
+
+	// premultiplied colors are shown on black
+	PixelColor(const Color color) :
+		value(getPalette() ? getPalette()->find(color) : 0) {}
+
+	constexpr Type
+	getValue() const
+	{ return value; }
+
+	constexpr Type
+	getIndex() const
+	{ return value; }
+
+	explicit
+	operator Color() const
+	{ return getPalette() ? getPalette()->getColor(value) : Color(0xff000000); }
+
+	constexpr bool
+	operator== (const ThisColor other) const
+	{ return value == other.value; }
+
+
+	// the palette is shared with `ColorAI4`
+	static inline void
+	setPalette(const Palette &palette)
+	{ ActivePalette<Depth>::palette = &palette; }
+
+	static inline const Palette *
+	getPalette()
+	{ return ActivePalette<Depth>::palette; }
+
+
+	// Porter and Duff's compositing operations
+	void
+	Clear(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void
+	Clear(const AlphaColor)
+	{ value = getPalette()->getBlack(); }
+
+
+	inline void
+	A(const ThisColor a)
+	{ value = a.value; }
+	inline void
+	A(const AlphaColor a)
+	{ value = flatten(a.getIndex(), a.getAlpha()); }
+
+	inline void
+	B(const ThisColor)
+	{ }
+	inline void
+	B(const AlphaColor)
+	{ }
+
+
+	void	// compose(a, 15, 0);
+	AoverB(const ThisColor a)
+	{ value = a.value; }
+	void
+	AoverB(const AlphaColor a)
+	{ value = getPalette()->mix(a.getIndex(), value, a.getAlpha() * 0x11); }
+
+	void	// compose(a, 0, 15);
+	BoverA(const ThisColor)
+	{ }
+	void	// compose(a, 0, 15);
+	BoverA(const AlphaColor)
+	{ }
+
+
+	void	// compose(a, 15, 0);
+	AinB(const ThisColor a)
+	{ value = a.value; }
+	void	// compose(a, 15, 0);
+	AinB(const AlphaColor a)
+	{ A(a); }
+
+	void	// compose(a, 0, 15);
+	BinA(const ThisColor)
+	{ }
+	void	// compose(a, 0, a.getAlpha());
+	BinA(const AlphaColor a)
+	{ value = flatten(value, a.getAlpha()); }
+
+
+	void	// compose(a, 0, 0);
+	AoutB(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void	// compose(a, 0, 0);
+	AoutB(const AlphaColor)
+	{ value = getPalette()->getBlack(); }
+
+	void	// compose(a, 0, 0);
+	BoutA(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void	// compose(a, 0, 15 - a.getAlpha());
+	BoutA(const AlphaColor a)
+	{ value = flatten(value, 15 - a.getAlpha()); }
+
+
+	void	// compose(a, 15, 0);
+	AatopB(const ThisColor a)
+	{ value = a.value; }
+	void	// compose(a, 15, 15 - a.getAlpha());
+	AatopB(const AlphaColor a)
+	{ AoverB(a); }
+
+	void	// compose(a, 0, 15);
+	BatopA(const ThisColor)
+	{ }
+	void	// compose(a, 0, a.getAlpha());
+	BatopA(const AlphaColor a)
+	{ BinA(a); }
+
+
+	void	// compose(a, 0, 0);
+	Xor(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void	// compose(a, 0, 15 - a.getAlpha());
+	Xor(const AlphaColor a)
+	{ BoutA(a); }
+
+	// the sum is searched in the palette, since it is not in the blend table
+	void
+	Plus(const ThisColor a)
+	{ value = getPalette()->add(a.value, value); }
+	void
+	Plus(const AlphaColor a)
+	{ value = getPalette()->add(flatten(a.getIndex(), a.getAlpha()), value); }
+
+protected:
+	static inline uint8_t
+	flatten(uint8_t index, uint8_t alpha)
+	{ return getPalette()->flatten(index, alpha * 0x11); }
+
+private:
+	Type value{0};
+};
+
+using ColorI4 = PixelColor<PixelFormat::I4>;
+
+
+} // namespace ges
+
+} // namespace modm
@@ -0,0 +1,338 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_PIXEL_COLOR_HPP
+#	error	"Don't include this file directly, use 'pixel_color.hpp' instead!"
+#endif
+
+#include <stdint.h>
+#include "../pixel_format.hpp"
+
+namespace modm
+{
+
+namespace ges
+{
+
+
+// Index into the palette with straight alpha.
+// The palette must be set before any color is converted or composed.
+template<>
+class PixelColor<PixelFormat::AI8>
+{
+	using ThisColor = PixelColor<PixelFormat::AI8>;
+public:
+	using Type = uint16_t;
+	using AlphaColor = ThisColor;
+	static constexpr uint8_t Depth = 8;
+	static constexpr uint8_t Bits = 16;
+	static constexpr PixelFormat Format = PixelFormat::AI8;
+
+	constexpr
+	PixelColor() = default;
+
+	constexpr
+	PixelColor(const PixelColor &) = default;
+
+	explicit constexpr
+	PixelColor(const Type value) :
+		value(value) {}
+
+	constexpr
+	PixelColor(const uint8_t index, const uint8_t alpha) :
+		parts{index, alpha} {}
+
+	PixelColor(const Color color) :
+		parts{getPalette() ? getPalette()->find(Color(unpremultiply(color.getRed(), color.getAlpha()),
+														unpremultiply(color.getGreen(), color.getAlpha()),
+														unpremultiply(color.getBlue(), color.getAlpha()))) : uint8_t(0),
+			  color.getAlpha()} {}
+
+	constexpr Type
+	getValue() const
+	{ return value; }
+
+	constexpr uint8_t
+	getIndex() const
+	{ return parts[0]; }
+
+	constexpr uint8_t
+	getAlpha() const
+	{ return parts[1]; }
+
+	explicit
+	operator Color() const
+	{
+		if (getPalette() == nullptr) return Color();
+		const Color color = getPalette()->getColor(parts[0]);
+		return Color(color.getRed(), color.getGreen(), color.getBlue(), parts[1]);
+	}
+
+	constexpr bool
+	operator== (const ThisColor other) const
+	{ return value == other.value; }
+
+
+	// the palette is shared with `ColorI8`
+	static inline void
+	setPalette(const Palette &palette)
+	{ ActivePalette<Depth>::palette = &palette; }
+
+	static inline const Palette *
+	getPalette()
+	{ return ActivePalette<Depth>::palette; }
+
+
+	// Porter and Duff's compositing operations
+	void
+	Clear(const ThisColor)
+	{ value = 0; }
+
+
+	void
+	A(const ThisColor a)
+	{ value = a.value; }
+
+	void
+	B(const ThisColor)
+	{ }
+
+
+	void
+	AoverB(const ThisColor a)
+	{ compose(a, 255, 255 - a.getAlpha()); }
+
+	void
+	BoverA(const ThisColor a)
+	{ compose(a, 255 - getAlpha(), 255); }
+
+
+	void
+	AinB(const ThisColor a)
+	{ compose(a, getAlpha(), 0); }
+
+	void
+	BinA(const ThisColor a)
+	{ compose(a, 0, a.getAlpha()); }
+
+
+	void
+	AoutB(const ThisColor a)
+	{ compose(a, 255 - getAlpha(), 0); }
+
+	void
+	BoutA(const ThisColor a)
+	{ compose(a, 0, 255 - a.getAlpha()); }
+
+
+	void
+	AatopB(const ThisColor a)
+	{ compose(a, getAlpha(), 255 - a.getAlpha()); }
+
+	void
+	BatopA(const ThisColor a)
+	{ compose(a, 255 - getAlpha(), a.getAlpha()); }
+
+
+	void
+	Xor(const ThisColor a)
+	{ compose(a, 255 - getAlpha(), 255 - a.getAlpha()); }
+
+
+	void
+	Plus(const ThisColor a)
+	{ compose(a, 255, 255); }
+
+protected:
+	// see Porter and Duff's "Compositing Digital Images", the colors are mixed
+	// by the blend table of the palette
+	void
+	compose(const ThisColor cA, const uint8_t fa, const uint8_t fb)
+	{
+		parts[0] = getPalette()->compose(cA.parts[0], cA.parts[1], fa, parts[0], parts[1], fb, parts[1]);
+	}
+
+	static constexpr uint8_t
+	unpremultiply(const uint8_t channel, const uint8_t alpha)
+	{ return alpha ? ((channel >= alpha) ? 255 : uint8_t(uint16_t(channel) * 255 / alpha)) : 0; }
+
+private:
+	union
+	{
+		uint16_t value{0};
+		uint8_t parts[2];
+	};
+
+	friend
+	class PixelColor<PixelFormat::I8>;
+};
+
+using ColorAI8 = PixelColor<PixelFormat::AI8>;
+
+
+// Opaque index into the palette.
+template<>
+class PixelColor<PixelFormat::I8>
+{
+	using ThisColor = PixelColor<PixelFormat::I8>;
+public:
+	using Type = uint8_t;
+	using AlphaColor = PixelColor<PixelFormat::AI8>;
+	static constexpr uint8_t Depth = 8;
+	static constexpr uint8_t Bits = 8;
+	static constexpr PixelFormat Format = PixelFormat::I8;
+
+	constexpr
+	PixelColor() = default;
+
+	constexpr
+	PixelColor(const PixelColor &) = default;
+
+	explicit constexpr
+	PixelColor(const Type index) :
+		value(index) {}
+
+	// premultiplied colors are shown on black
+	PixelColor(const Color color) :
+		value(getPalette() ? getPalette()->find(color) : 0) {}
+
+	constexpr Type
+	getValue() const
+	{ return value; }
+
+	constexpr Type
+	getIndex() const
+	{ return value; }
+
+	explicit
+	operator Color() const
+	{ return getPalette() ? getPalette()->getColor(value) : Color(0xff000000); }
+
+	constexpr bool
+	operator== (const ThisColor other) const
+	{ return value == other.value; }
+
+
+	// the palette is shared with `ColorAI8`
+	static inline void
+	setPalette(const Palette &palette)
+	{ ActivePalette<Depth>::palette = &palette; }
+
+	static inline const Palette *
+	getPalette()
+	{ return ActivePalette<Depth>::palette; }
+
+
+	// Porter and Duff's compositing operations
+	void
+	Clear(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void
+	Clear(const AlphaColor)
+	{ value = getPalette()->getBlack(); }
+
+
+	inline void
+	A(const ThisColor a)
+	{ value = a.value; }
+	inline void
+	A(const AlphaColor a)
+	{ value = getPalette()->flatten(a.parts[0], a.parts[1]); }
+
+	inline void
+	B(const ThisColor)
+	{ }
+	inline void
+	B(const AlphaColor)
+	{ }
+
+
+	void	// compose(a, 255, 0);
+	AoverB(const ThisColor a)
+	{ value = a.value; }
+	void
+	AoverB(const AlphaColor a)
+	{ value = getPalette()->mix(a.parts[0], value, a.parts[1]); }
+
+	void	// compose(a, 0, 255);
+	BoverA(const ThisColor)
+	{ }
+	void	// compose(a, 0, 255);
+	BoverA(const AlphaColor)
+	{ }
+
+
+	void	// compose(a, 255, 0);
+	AinB(const ThisColor a)
+	{ value = a.value; }
+	void	// compose(a, 255, 0);
+	AinB(const AlphaColor a)
+	{ A(a); }
+
+	void	// compose(a, 0, 255);
+	BinA(const ThisColor)
+	{ }
+	void	// compose(a, 0, a.getAlpha());
+	BinA(const AlphaColor a)
+	{ value = getPalette()->flatten(value, a.parts[1]); }
+
+
+	void	// compose(a, 0, 0);
+	AoutB(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void	// compose(a, 0, 0);
+	AoutB(const AlphaColor)
+	{ value = getPalette()->getBlack(); }
+
+	void	// compose(a, 0, 0);
+	BoutA(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void	// compose(a, 0, 255 - a.getAlpha());
+	BoutA(const AlphaColor a)
+	{ value = getPalette()->flatten(value, 255 - a.parts[1]); }
+
+
+	void	// compose(a, 255, 0);
+	AatopB(const ThisColor a)
+	{ value = a.value; }
+	void	// compose(a, 255, 255 - a.getAlpha());
+	AatopB(const AlphaColor a)
+	{ AoverB(a); }
+
+	void	// compose(a, 0, 255);
+	BatopA(const ThisColor)
+	{ }
+	void	// compose(a, 0, a.getAlpha());
+	BatopA(const AlphaColor a)
+	{ BinA(a); }
+
+
+	void	// compose(a, 0, 0);
+	Xor(const ThisColor)
+	{ value = getPalette()->getBlack(); }
+	void	// compose(a, 0, 255 - a.getAlpha());
+	Xor(const AlphaColor a)
+	{ BoutA(a); }
+
+	// the sum is searched in the palette, since it is not in the blend table
+	void
+	Plus(const ThisColor a)
+	{ value = getPalette()->add(a.value, value); }
+	void
+	Plus(const AlphaColor a)
+	{ value = getPalette()->add(getPalette()->flatten(a.parts[0], a.parts[1]), value); }
+
+private:
+	Type value{0};
+};
+
+using ColorI8 = PixelColor<PixelFormat::I8>;
+
+
+} // namespace ges
+
+} // namespace modm
@@ -27,11 +27,7 @@ public:
 	using Type = uint8_t;
 	using AlphaColor = ThisColor;
 	static constexpr uint8_t Depth = 2;
-#ifdef XPCC__OS_HOSTED
-	static constexpr uint8_t Bits = 8;
-#else
 	static constexpr uint8_t Bits = 4;
-#endif
 	static constexpr PixelFormat Format = PixelFormat::AL2;
 
 	constexpr
@@ -175,11 +171,7 @@ public:
 	using Type = uint8_t;
 	using AlphaColor = PixelColor<PixelFormat::AL2>;
 	static constexpr uint8_t Depth = 2;
-#ifdef XPCC__OS_HOSTED
-	static constexpr uint8_t Bits = 8;
-#else
 	static constexpr uint8_t Bits = 2;
-#endif
 	static constexpr PixelFormat Format = PixelFormat::L2;
 
 	constexpr
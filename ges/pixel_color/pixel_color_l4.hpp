@@ -171,11 +171,7 @@ public:
 	using Type = uint8_t;
 	using AlphaColor = PixelColor<PixelFormat::AL4>;
 	static constexpr uint8_t Depth = 4;
-#ifdef XPCC__OS_HOSTED
-	static constexpr uint8_t Bits = 8;
-#else
 	static constexpr uint8_t Bits = 4;
-#endif
 	static constexpr PixelFormat Format = PixelFormat::L4;
 
 	constexpr
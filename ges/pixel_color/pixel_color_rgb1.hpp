@@ -27,11 +27,7 @@ public:
 	using Type = uint8_t;
 	using AlphaColor = ThisColor;
 	static constexpr uint8_t Depth = 3;
-#ifdef XPCC__OS_HOSTED
-	static constexpr uint8_t Bits = 8;
-#else
 	static constexpr uint8_t Bits = 4;
-#endif
 	static constexpr PixelFormat Format = PixelFormat::ARGB1;
 
 	constexpr
@@ -64,7 +60,7 @@ public:
 
 	constexpr Type
 	getRed() const
-	{ return value & 0b1; }
+	{ return (value & 0b100) >> 2; }
 
 	constexpr Type
 	getGreen() const
@@ -72,7 +68,7 @@ public:
 
 	constexpr Type
 	getBlue() const
-	{ return (value & 0b100) >> 2; }
+	{ return value & 0b1; }
 
 	constexpr Type
 	getAlpha() const
@@ -82,9 +78,9 @@ public:
 	operator Color() const
 	{
 		return Color(((value & 0b1000) * 0x1fe00000) |
-					 ((value & 0b0100) * 0x3fc000) |
+					 ((value & 0b0001) * 0xff0000) |
 					 ((value & 0b0010) * 0x7f80) |
-					 ((value & 0b0001) * 0xff));
+					 ((value >> 2 & 0b1) * 0xff));
 	}
 
 	constexpr bool
@@ -178,11 +174,7 @@ public:
 	using Type = uint8_t;
 	using AlphaColor = PixelColor<PixelFormat::ARGB1>;
 	static constexpr uint8_t Depth = 3;
-#ifdef XPCC__OS_HOSTED
-	static constexpr uint8_t Bits = 8;
-#else
 	static constexpr uint8_t Bits = 4;
-#endif
 	static constexpr PixelFormat Format = PixelFormat::RGB1;
 
 	constexpr
@@ -213,7 +205,7 @@ public:
 
 	constexpr Type
 	getRed() const
-	{ return value & 0b1; }
+	{ return (value & 0b100) >> 2; }
 
 	constexpr Type
 	getGreen() const
@@ -221,15 +213,15 @@ public:
 
 	constexpr Type
 	getBlue() const
-	{ return value >> 2; }
+	{ return value & 0b1; }
 
 	explicit constexpr
 	operator Color() const
 	{
 		return Color(0xff000000 |
-					 ((value & 0b0100) * 0x3fc000) |
+					 ((value & 0b0001) * 0xff0000) |
 					 ((value & 0b0010) * 0x7f80) |
-					 ((value & 0b0001) * 0xff));
+					 ((value >> 2 & 0b1) * 0xff));
 	}
 
 	constexpr bool
@@ -46,6 +46,13 @@ PixelFormat
 
 	RGB8 = 16,
 	ARGB8 = 17,
+
+	// indices into a palette
+	I4 = 18,
+	AI4 = 19,
+
+	I8 = 20,
+	AI8 = 21,
 };
 
 constexpr uint8_t
@@ -58,25 +65,25 @@ bitsPerPixel(PixelFormat format)
 
 		case PixelFormat::AL1:
 		case PixelFormat::L2:
-#ifndef XPCC__OS_HOSTED
 			return 2;
-#endif
 
 		case PixelFormat::AL2:
 		case PixelFormat::L4:
+		case PixelFormat::I4:
 		case PixelFormat::RGB1:
 		case PixelFormat::ARGB1:
-#ifndef XPCC__OS_HOSTED
 			return 4;
-#endif
 
 		case PixelFormat::AL4:
+		case PixelFormat::AI4:
 		case PixelFormat::L8:
+		case PixelFormat::I8:
 		case PixelFormat::RGB332:
 		case PixelFormat::ARGB2:
 			return 8;
 
 		case PixelFormat::AL8:
+		case PixelFormat::AI8:
 		case PixelFormat::ARGB4:
 		case PixelFormat::ARGB1555:
 		case PixelFormat::RGB565:
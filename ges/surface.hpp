@@ -24,6 +24,29 @@ namespace modm
 namespace ges
 {
 
+// clockwise rotation of the logical image in the physical buffer,
+// for panels which are mounted rotated
+enum class
+Orientation : uint8_t
+{
+	Normal,
+	Rotate90,
+	Rotate180,
+	Rotate270,
+};
+
+// order of the pixels in the bytes of packed surfaces, most panels with one bit
+// per pixel expect the first pixel in the highest bit
+enum class
+PixelOrder : uint8_t
+{
+	LsbFirst,
+	MsbFirst,
+	// only for one bit per pixel: 8 vertical pixels per byte with the top one
+	// in the lowest bit, every 8 rows form a page like in SSD1306 controllers
+	Pages,
+};
+
 template< PixelFormat Format >
 class Surface
 {
@@ -36,17 +59,23 @@ public:
 	using Buffer = PixelBuffer<Width, Height, Format>;
 
 public:
-	Surface(uint8_t *const buffer, const uint16_t width, const uint16_t height) :
-		width(width), height(height), buffer((BufferType*)buffer)
+	// width and height are those of the physical buffer
+	Surface(uint8_t *const buffer, const uint16_t width, const uint16_t height,
+			const Orientation orientation = Orientation::Normal) :
+		width(isSwapped(orientation) ? height : width),
+		height(isSwapped(orientation) ? width : height),
+		buffer((BufferType*)buffer), orientation(orientation),
+		origin((BufferType*)buffer + getOrigin(orientation, width, height)),
+		stepX(getStepX(orientation, width)), stepY(getStepY(orientation, width))
 	{}
 
-	Surface(uint8_t *const buffer, const Size size) :
-		Surface(buffer, size.getWidth(), size.getHeight())
+	Surface(uint8_t *const buffer, const Size size, const Orientation orientation = Orientation::Normal) :
+		Surface(buffer, size.getWidth(), size.getHeight(), orientation)
 	{}
 
 	template< uint16_t Width, uint16_t Height >
-	Surface(PixelBuffer<Width, Height, Format> &buffer) :
-		Surface(buffer.getData(), Width, Height)
+	Surface(PixelBuffer<Width, Height, Format> &buffer, const Orientation orientation = Orientation::Normal) :
+		Surface(buffer.getData(), Width, Height, orientation)
 	{}
 
 	uint16_t
@@ -69,6 +98,10 @@ public:
 	getPixelFormat()
 	{ return Format; }
 
+	Orientation
+	getOrientation() const
+	{ return orientation; }
+
 	Rect
 	clip(Rect input) const
 	{
@@ -91,7 +124,7 @@ public:
 	void
 	setPixel(uint16_t x, uint16_t y, NativeColor color)
 	{
-		buffer[y * width + x] = color.getValue();
+		*getAddress(x, y) = color.getValue();
 	}
 
 	inline void
@@ -115,7 +148,7 @@ public:
 	NativeColor
 	getPixel(uint16_t x, uint16_t y) const
 	{
-		return NativeColor(buffer[y * width + x]);
+		return NativeColor(*getAddress(x, y));
 	}
 
 	NativeColor
@@ -124,24 +157,114 @@ public:
 		return getPixel(p.getX(), p.getY());
 	}
 
+	// sets the pixels from beginX to endX
+	void
+	fillSpan(uint16_t y, uint16_t beginX, uint16_t endX, NativeColor color)
+	{
+		if (hasContiguousRows())
+			std::fill_n(getAddress(beginX, y), endX - beginX + 1, color.getValue());
+		else if (hasReversedRows())
+			std::fill_n(getAddress(endX, y), endX - beginX + 1, color.getValue());
+		else for (uint16_t xx = beginX; xx <= endX; xx++)
+			setPixel(xx, y, color);
+	}
+
+	// sets the pixels from beginY to endY
+	void
+	fillColumn(uint16_t x, uint16_t beginY, uint16_t endY, NativeColor color)
+	{
+		BufferType *pixel = getAddress(x, beginY);
+		for (uint16_t yy = beginY; yy <= endY; yy++, pixel += stepY)
+			*pixel = color.getValue();
+	}
+
+	// copies `length` pixels from a row of the source, which must not overlap
+	void
+	copySpan(uint16_t y, uint16_t beginX, const Surface &source, uint16_t sourceX, uint16_t sourceY, uint16_t length)
+	{
+		if (unlikely(length == 0)) return;
+		const uint16_t endX = beginX + length - 1, sourceEndX = sourceX + length - 1;
+		if (hasContiguousRows() and source.hasContiguousRows())
+			std::memcpy(getAddress(beginX, y), source.getAddress(sourceX, sourceY), length * sizeof(BufferType));
+		else if (hasReversedRows() and source.hasReversedRows())
+			std::memcpy(getAddress(endX, y), source.getAddress(sourceEndX, sourceY), length * sizeof(BufferType));
+		else if (hasContiguousRows() and source.hasReversedRows())
+			std::reverse_copy(source.getAddress(sourceEndX, sourceY), source.getAddress(sourceX, sourceY) + 1, getAddress(beginX, y));
+		else if (hasReversedRows() and source.hasContiguousRows())
+			std::reverse_copy(source.getAddress(sourceX, sourceY), source.getAddress(sourceEndX, sourceY) + 1, getAddress(endX, y));
+		else for (uint16_t ii = 0; ii < length; ii++)
+			setPixel(beginX + ii, y, source.getPixel(sourceX + ii, sourceY));
+	}
+
 	template <PixelFormat CompositeFormat>
 	inline void
 	compositePixel(uint16_t x, uint16_t y, const PixelColor<CompositeFormat> color, void (NativeColor::*composition)(const PixelColor<CompositeFormat>) = &NativeColor::A)
 	{
-		(reinterpret_cast<NativeColor*>(buffer + y * width + x)->*composition)(color);
+		(reinterpret_cast<NativeColor*>(getAddress(x, y))->*composition)(color);
 	}
 
 	template <PixelFormat CompositeFormat>
 	inline void
 	compositePixel(const Point p, const PixelColor<CompositeFormat> color, void (NativeColor::*composition)(const PixelColor<CompositeFormat>) = &NativeColor::A)
 	{
-		(reinterpret_cast<NativeColor*>(buffer + p.getY() * width + p.getX())->*composition)(color);
+		compositePixel(p.getX(), p.getY(), color, composition);
+	}
+
+protected:
+	inline BufferType *
+	getAddress(uint16_t x, uint16_t y) const
+	{ return origin + x * stepX + y * stepY; }
+
+	// only then can rows be accessed with memcpy and fill_n
+	inline bool
+	hasContiguousRows() const
+	{ return stepX == 1; }
+
+	// rows of surfaces rotated by 180 degrees are contiguous from their end
+	inline bool
+	hasReversedRows() const
+	{ return stepX == -1; }
+
+	static constexpr bool
+	isSwapped(Orientation orientation)
+	{ return orientation == Orientation::Rotate90 or orientation == Orientation::Rotate270; }
+
+	// offset of the logical origin in the physical buffer
+	static constexpr int32_t
+	getOrigin(Orientation orientation, uint16_t width, uint16_t height)
+	{
+		return (orientation == Orientation::Rotate90)  ? width - 1 :
+			   (orientation == Orientation::Rotate180) ? int32_t(width) * height - 1 :
+			   (orientation == Orientation::Rotate270) ? int32_t(width) * (height - 1) : 0;
+	}
+
+	// physical step for the next logical column
+	static constexpr int32_t
+	getStepX(Orientation orientation, uint16_t width)
+	{
+		return (orientation == Orientation::Rotate90)  ? width :
+			   (orientation == Orientation::Rotate180) ? -1 :
+			   (orientation == Orientation::Rotate270) ? -int32_t(width) : 1;
+	}
+
+	// physical step for the next logical row
+	static constexpr int32_t
+	getStepY(Orientation orientation, uint16_t width)
+	{
+		return (orientation == Orientation::Rotate90)  ? -1 :
+			   (orientation == Orientation::Rotate180) ? -int32_t(width) :
+			   (orientation == Orientation::Rotate270) ? 1 : width;
 	}
 
 protected:
+	// logical dimensions
 	const uint16_t width;
 	const uint16_t height;
 	BufferType *const buffer;
+	const Orientation orientation;
+	BufferType *const origin;
+	const int32_t stepX;
+	const int32_t stepY;
 
 	template < PixelFormat F >
 	friend class Painter;
@@ -152,7 +275,6 @@ protected:
 } // namespace modm
 
 
-#include "surface/surface_l1.hpp"
-#include "surface/surface_l4.hpp"
+#include "surface/surface_packed.hpp"
 
 #endif // MODM_GES_SURFACE_HPP
@@ -0,0 +1,528 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_SURFACE_HPP
+#	error	"Don't include this file directly, use 'surface.hpp' instead!"
+#endif
+
+namespace modm
+{
+
+namespace ges
+{
+
+// Several pixels per byte, by default the first one in the lowest bits like
+// `QImage::Format_MonoLSB`. Rows start at byte boundaries, on hosted builds as
+// well as on the targets. Surfaces with one bit per pixel may instead be
+// organized in pages of 8 rows, which track the pages written since the
+// last flush. Like `Surface`, the logical image may be rotated in the buffer,
+// then logical rows are written as physical columns or reversed rows.
+template< uint8_t BitsPerPixel, PixelFormat Format >
+class PackedSurface
+{
+	static_assert(BitsPerPixel == 1 or BitsPerPixel == 2 or BitsPerPixel == 4,
+				  "Packed surfaces have 1, 2 or 4 bits per pixel!");
+	friend class QDisplay;
+
+	static constexpr uint8_t PixelsPerByte = 8 / BitsPerPixel;
+	static constexpr uint8_t Mask = (1 << BitsPerPixel) - 1;
+	// the value of every pixel in a byte, e.g. 0x11 for 4 bits
+	static constexpr uint8_t Replicate = 0xff / Mask;
+
+public:
+	using NativeColor = PixelColor<Format>;
+
+	template< uint16_t Width, uint16_t Height >
+	using Buffer = PixelBuffer<Width, Height, Format>;
+
+public:
+	// the buffer holds `height` rows of `(width * BitsPerPixel + 7) / 8` bytes,
+	// or `(height + 7) / 8` pages of `width` bytes, width and height are those
+	// of the physical buffer
+	PackedSurface(uint8_t *const buffer, const uint16_t width, const uint16_t height,
+				  const PixelOrder order = PixelOrder::LsbFirst, const Orientation orientation = Orientation::Normal) :
+		width(isSwapped(orientation) ? height : width),
+		height(isSwapped(orientation) ? width : height), buffer(buffer),
+		stride((order == PixelOrder::Pages) ? width : (width + PixelsPerByte - 1) / PixelsPerByte),
+		flip((order == PixelOrder::MsbFirst) ? PixelsPerByte - 1 : 0), paged(order == PixelOrder::Pages),
+		orientation(orientation)
+	{}
+
+	PackedSurface(uint8_t *const buffer, const Size size, const PixelOrder order = PixelOrder::LsbFirst,
+				  const Orientation orientation = Orientation::Normal) :
+		PackedSurface(buffer, size.getWidth(), size.getHeight(), order, orientation)
+	{}
+
+	template< uint16_t Width, uint16_t Height >
+	PackedSurface(PixelBuffer<Width, Height, Format> &buffer, const PixelOrder order = PixelOrder::LsbFirst,
+				  const Orientation orientation = Orientation::Normal) :
+		PackedSurface(buffer.getData(), Width, Height, order, orientation)
+	{}
+
+	uint16_t
+	getWidth() const
+	{ return width; }
+
+	uint16_t
+	getHeight() const
+	{ return height; }
+
+	Size
+	getSize() const
+	{ return Size(width, height); }
+
+	Rect
+	getBounds() const
+	{ return Rect(0,0, width-1, height-1); }
+
+	static constexpr PixelFormat
+	getPixelFormat()
+	{ return Format; }
+
+	PixelOrder
+	getPixelOrder() const
+	{ return isPaged() ? PixelOrder::Pages : flip ? PixelOrder::MsbFirst : PixelOrder::LsbFirst; }
+
+	Orientation
+	getOrientation() const
+	{ return orientation; }
+
+	Rect
+	clip(Rect input) const
+	{
+		if (input.isEmpty()) return getBounds();
+		return input.intersected(getBounds());
+	}
+
+	void
+	clear()
+	{
+		clear(NativeColor(0));
+	}
+
+	void
+	clear(NativeColor color)
+	{
+		const uint16_t rows = isPaged() ? (getPhysicalHeight() + 7) / 8 : getPhysicalHeight();
+		std::memset(buffer, color.getValue() * Replicate, std::size_t(stride) * rows);
+		if (isPaged()) markDirty(0, getPhysicalWidth() - 1, 0, getPhysicalHeight() - 1);
+	}
+
+	void
+	setPixel(uint16_t x, uint16_t y, NativeColor color)
+	{
+		setPhysicalPixel(getPhysicalX(x, y), getPhysicalY(x, y), color);
+	}
+
+	inline void
+	setPixel(Point p, NativeColor color)
+	{
+		setPixel(p.getX(), p.getY(), color);
+	}
+
+	void
+	clearPixel(uint16_t x, uint16_t y)
+	{
+		setPixel(x, y, NativeColor(0));
+	}
+
+	inline void
+	clearPixel(Point p)
+	{
+		setPixel(p.getX(), p.getY(), NativeColor(0));
+	}
+
+	NativeColor
+	getPixel(uint16_t x, uint16_t y) const
+	{
+		if (x < width and y < height)
+		{
+			const uint16_t px = getPhysicalX(x, y), py = getPhysicalY(x, y);
+			return NativeColor((*getAddress(px, py) >> getShift(px, py)) & Mask);
+		}
+		return NativeColor(0);
+	}
+
+	NativeColor
+	getPixel(Point p) const
+	{
+		return getPixel(p.getX(), p.getY());
+	}
+
+	// sets the pixels from beginX to endX, whole bytes at once
+	void
+	fillSpan(uint16_t y, uint16_t beginX, uint16_t endX, NativeColor color)
+	{
+		const uint16_t right = getPhysicalWidth() - 1, bottom = getPhysicalHeight() - 1;
+		switch (orientation)
+		{
+			case Orientation::Normal:    fillPhysicalRow(y, beginX, endX, color); break;
+			case Orientation::Rotate90:  fillPhysicalColumn(right - y, beginX, endX, color); break;
+			case Orientation::Rotate180: fillPhysicalRow(bottom - y, right - endX, right - beginX, color); break;
+			case Orientation::Rotate270: fillPhysicalColumn(y, bottom - endX, bottom - beginX, color); break;
+		}
+	}
+
+	// sets the pixels from beginY to endY, whole bytes at once in pages
+	void
+	fillColumn(uint16_t x, uint16_t beginY, uint16_t endY, NativeColor color)
+	{
+		const uint16_t right = getPhysicalWidth() - 1, bottom = getPhysicalHeight() - 1;
+		switch (orientation)
+		{
+			case Orientation::Normal:    fillPhysicalColumn(x, beginY, endY, color); break;
+			case Orientation::Rotate90:  fillPhysicalRow(x, right - endY, right - beginY, color); break;
+			case Orientation::Rotate180: fillPhysicalColumn(right - x, bottom - endY, bottom - beginY, color); break;
+			case Orientation::Rotate270: fillPhysicalRow(bottom - x, beginY, endY, color); break;
+		}
+	}
+
+	// copies `length` pixels from a row of the source, which must not overlap.
+	// Rows of surfaces with the same pixel order and orientation are copied as
+	// physical rows, all others pixel by pixel.
+	void
+	copySpan(uint16_t y, uint16_t beginX, const PackedSurface &source, uint16_t sourceX, uint16_t sourceY, uint16_t length)
+	{
+		if (unlikely(length == 0)) return;
+		if (unlikely(source.flip != flip or source.isPaged() or isPaged() or source.orientation != orientation or
+					 isSwapped(orientation)))
+		{
+			for (uint16_t ii = 0; ii < length; ii++)
+				setPixel(beginX + ii, y, source.getPixel(sourceX + ii, sourceY));
+			return;
+		}
+
+		// reversed rows of both surfaces are copied from their physical begin
+		const uint16_t last = beginX + length - 1, sourceLast = sourceX + length - 1;
+		copyPhysicalRow(getPhysicalY(beginX, y), getPhysicalX((orientation == Orientation::Normal) ? beginX : last, y), source,
+				source.getPhysicalX((orientation == Orientation::Normal) ? sourceX : sourceLast, sourceY),
+				source.getPhysicalY(sourceX, sourceY), length);
+	}
+
+	// Pages written since the last `clearDirty()`, bit n is set for page n of
+	// the first 256 physical rows. Within them only the physical columns from
+	// `getDirtyLeft()` to `getDirtyRight()` changed and need to be sent to the
+	// controller.
+	inline uint32_t
+	getDirtyPages() const
+	{ return dirtyPages; }
+
+	inline uint16_t
+	getDirtyLeft() const
+	{ return dirtyLeft; }
+
+	inline uint16_t
+	getDirtyRight() const
+	{ return dirtyRight; }
+
+	inline void
+	clearDirty()
+	{
+		dirtyPages = 0;
+		dirtyLeft = UINT16_MAX;
+		dirtyRight = 0;
+	}
+
+	template <PixelFormat CompositeFormat>
+	inline void
+	compositePixel(uint16_t x, uint16_t y, const PixelColor<CompositeFormat> color, void (NativeColor::*composition)(const PixelColor<CompositeFormat>) = &NativeColor::A)
+	{
+		NativeColor pixel(getPixel(x, y));
+		(pixel.*composition)(color);
+		setPixel(x, y, pixel);
+	}
+
+	template <PixelFormat CompositeFormat>
+	inline void
+	compositePixel(const Point p, const PixelColor<CompositeFormat> color, void (NativeColor::*composition)(const PixelColor<CompositeFormat>) = &NativeColor::A)
+	{
+		NativeColor pixel(getPixel(p));
+		(pixel.*composition)(color);
+		setPixel(p, pixel);
+	}
+
+protected:
+	static constexpr bool
+	isSwapped(Orientation orientation)
+	{ return orientation == Orientation::Rotate90 or orientation == Orientation::Rotate270; }
+
+	inline uint16_t
+	getPhysicalWidth() const
+	{ return isSwapped(orientation) ? height : width; }
+
+	inline uint16_t
+	getPhysicalHeight() const
+	{ return isSwapped(orientation) ? width : height; }
+
+	// the logical image is rotated clockwise in the buffer
+	inline uint16_t
+	getPhysicalX(uint16_t x, uint16_t y) const
+	{
+		switch (orientation)
+		{
+			case Orientation::Rotate90:  return getPhysicalWidth() - 1 - y;
+			case Orientation::Rotate180: return getPhysicalWidth() - 1 - x;
+			case Orientation::Rotate270: return y;
+			default: return x;
+		}
+	}
+
+	inline uint16_t
+	getPhysicalY(uint16_t x, uint16_t y) const
+	{
+		switch (orientation)
+		{
+			case Orientation::Rotate90:  return x;
+			case Orientation::Rotate180: return getPhysicalHeight() - 1 - y;
+			case Orientation::Rotate270: return getPhysicalHeight() - 1 - x;
+			default: return y;
+		}
+	}
+
+	// all following coordinates are physical
+
+	// the byte containing the pixel, packed rows are only copied by `copyPhysicalRow`
+	inline uint8_t *
+	getAddress(uint16_t x, uint16_t y) const
+	{
+		if (isPaged()) return buffer + (y / 8) * stride + x;
+		return buffer + y * stride + x / PixelsPerByte;
+	}
+
+	// the position of the pixel in its byte is mirrored for MSB first order
+	inline uint8_t
+	getShift(uint16_t x, uint16_t y) const
+	{
+		if (isPaged()) return y % 8;
+		return ((x % PixelsPerByte) ^ flip) * BitsPerPixel;
+	}
+
+	inline void
+	setPhysicalPixel(uint16_t x, uint16_t y, NativeColor color)
+	{
+		uint8_t &byte = *getAddress(x, y);
+		const uint8_t shift = getShift(x, y);
+		byte = (byte & ~(Mask << shift)) | ((color.getValue() & Mask) << shift);
+		if (isPaged()) markDirty(x, x, y, y);
+	}
+
+	// sets the pixels of the row from left to right
+	void
+	fillPhysicalRow(uint16_t y, uint16_t left, uint16_t right, NativeColor color)
+	{
+		const uint8_t pattern = (color.getValue() & Mask) * Replicate;
+		if (isPaged())
+		{
+			// the same bit in one byte per column
+			const uint8_t bit = 1 << (y % 8);
+			uint8_t *byte = getAddress(left, y);
+			for (uint16_t xx = left; xx <= right; xx++, byte++)
+				*byte = (*byte & ~bit) | (pattern & bit);
+			markDirty(left, right, y, y);
+			return;
+		}
+
+		uint8_t *first = getAddress(left, y);
+		uint8_t *last = getAddress(right, y);
+		uint8_t head = getHeadMask(left);
+		const uint8_t tail = getTailMask(right);
+
+		if (first == last) head &= tail;
+		*first = (*first & ~head) | (pattern & head);
+		if (first == last) return;
+
+		std::memset(first + 1, pattern, last - first - 1);
+		*last = (*last & ~tail) | (pattern & tail);
+	}
+
+	// sets the pixels of the column from top to bottom
+	void
+	fillPhysicalColumn(uint16_t x, uint16_t top, uint16_t bottom, NativeColor color)
+	{
+		const uint8_t pattern = (color.getValue() & Mask) * Replicate;
+		if (not isPaged())
+		{
+			// the same pixel in one byte per row
+			const uint8_t mask = Mask << getShift(x, top);
+			uint8_t *byte = getAddress(x, top);
+			for (uint16_t yy = top; yy <= bottom; yy++, byte += stride)
+				*byte = (*byte & ~mask) | (pattern & mask);
+			return;
+		}
+
+		uint8_t *first = getAddress(x, top);
+		uint8_t *last = getAddress(x, bottom);
+		// masks of the rows in the first and last page
+		uint8_t head = 0xff << (top % 8);
+		const uint8_t tail = 0xff >> (7 - bottom % 8);
+		markDirty(x, x, top, bottom);
+
+		if (first == last) head &= tail;
+		*first = (*first & ~head) | (pattern & head);
+		if (first == last) return;
+
+		for (uint8_t *byte = first + stride; byte < last; byte += stride)
+			*byte = pattern;
+		*last = (*last & ~tail) | (pattern & tail);
+	}
+
+	// Copies `length` pixels of unpaged rows with the same pixel order.
+	// Whole bytes are copied if the pixels have the same position in their
+	// bytes, otherwise every byte is shifted together from two source bytes.
+	void
+	copyPhysicalRow(uint16_t y, uint16_t left, const PackedSurface &source, uint16_t sourceX, uint16_t sourceY, uint16_t length)
+	{
+		uint8_t *first = getAddress(left, y);
+		uint8_t *last = getAddress(left + length - 1, y);
+		const uint8_t *from = source.getAddress(sourceX, sourceY);
+		const uint8_t *to = source.getAddress(sourceX + length - 1, sourceY);
+		uint8_t head = getHeadMask(left);
+		const uint8_t tail = getTailMask(left + length - 1);
+		if (first == last) head &= tail;
+
+		// bits of the source before the first byte of the destination
+		const int16_t offset = (int16_t(sourceX % PixelsPerByte) - int16_t(left % PixelsPerByte)) * BitsPerPixel;
+		if (offset == 0)
+		{
+			*first = (*first & ~head) | (*from & head);
+			if (first == last) return;
+			std::memcpy(first + 1, from + 1, last - first - 1);
+			*last = (*last & ~tail) | (*to & tail);
+			return;
+		}
+
+		// the source bytes around the span are masked out and never read
+		auto byteAt = [from, to](int16_t index) -> uint16_t
+		{ return (index >= 0 and from + index <= to) ? from[index] : 0; };
+
+		for (uint8_t *byte = first; byte <= last; byte++)
+		{
+			const int16_t bit = offset + (byte - first) * 8 + 8;
+			const int16_t index = bit / 8 - 1;
+			const uint8_t shift = bit % 8;
+			const uint8_t value = flip ? uint8_t(((byteAt(index) << 8 | byteAt(index + 1)) << shift) >> 8) :
+										 uint8_t((byteAt(index + 1) << 8 | byteAt(index)) >> shift);
+			const uint8_t mask = (byte == first) ? head : (byte == last) ? tail : 0xff;
+			*byte = (*byte & ~mask) | (value & mask);
+		}
+	}
+
+	// pages are only supported with one bit per pixel
+	inline bool
+	isPaged() const
+	{ return BitsPerPixel == 1 and paged; }
+
+	inline void
+	markDirty(uint16_t left, uint16_t right, uint16_t top, uint16_t bottom)
+	{
+		if (top >= 256) return;
+		const uint8_t last = std::min(bottom, uint16_t(255)) / 8;
+		// the bits from the first to the last page, the shift wraps to all bits for page 31
+		dirtyPages |= ((uint32_t(2) << last) - 1) & ~((uint32_t(1) << (top / 8)) - 1);
+		dirtyLeft = std::min(dirtyLeft, left);
+		dirtyRight = std::max(dirtyRight, right);
+	}
+
+	// mask of the pixels from `x` to the end of its byte
+	inline uint8_t
+	getHeadMask(uint16_t x) const
+	{
+		const uint8_t bits = (x % PixelsPerByte) * BitsPerPixel;
+		return flip ? uint8_t(0xff >> bits) : uint8_t(0xff << bits);
+	}
+
+	// mask of the pixels from the start of the byte to `x`
+	inline uint8_t
+	getTailMask(uint16_t x) const
+	{
+		const uint8_t bits = 8 - (x % PixelsPerByte + 1) * BitsPerPixel;
+		return flip ? uint8_t(0xff << bits) : uint8_t(0xff >> bits);
+	}
+
+	static constexpr bool
+	hasContiguousRows()
+	{ return false; }
+
+protected:
+	// logical dimensions
+	const uint16_t width;
+	const uint16_t height;
+	uint8_t *const buffer;
+	const uint16_t stride;
+	// `PixelsPerByte - 1` for MSB first order, otherwise 0
+	const uint8_t flip;
+	const bool paged;
+	const Orientation orientation;
+
+	uint32_t dirtyPages{0};
+	uint16_t dirtyLeft{UINT16_MAX};
+	uint16_t dirtyRight{0};
+
+	template < PixelFormat F >
+	friend class Painter;
+};
+
+template<>
+class Surface<PixelFormat::L1> : public PackedSurface<1, PixelFormat::L1>
+{
+public:
+	using PackedSurface<1, PixelFormat::L1>::PackedSurface;
+};
+
+template<>
+class Surface<PixelFormat::AL1> : public PackedSurface<2, PixelFormat::AL1>
+{
+public:
+	using PackedSurface<2, PixelFormat::AL1>::PackedSurface;
+};
+
+template<>
+class Surface<PixelFormat::L2> : public PackedSurface<2, PixelFormat::L2>
+{
+public:
+	using PackedSurface<2, PixelFormat::L2>::PackedSurface;
+};
+
+template<>
+class Surface<PixelFormat::AL2> : public PackedSurface<4, PixelFormat::AL2>
+{
+public:
+	using PackedSurface<4, PixelFormat::AL2>::PackedSurface;
+};
+
+template<>
+class Surface<PixelFormat::L4> : public PackedSurface<4, PixelFormat::L4>
+{
+public:
+	using PackedSurface<4, PixelFormat::L4>::PackedSurface;
+};
+
+template<>
+class Surface<PixelFormat::RGB1> : public PackedSurface<4, PixelFormat::RGB1>
+{
+public:
+	using PackedSurface<4, PixelFormat::RGB1>::PackedSurface;
+};
+
+template<>
+class Surface<PixelFormat::ARGB1> : public PackedSurface<4, PixelFormat::ARGB1>
+{
+public:
+	using PackedSurface<4, PixelFormat::ARGB1>::PackedSurface;
+};
+
+// indices into a palette of 16 colors
+template<>
+class Surface<PixelFormat::I4> : public PackedSurface<4, PixelFormat::I4>
+{
+public:
+	using PackedSurface<4, PixelFormat::I4>::PackedSurface;
+};
+
+} // namespace ges
+
+} // namespace modm
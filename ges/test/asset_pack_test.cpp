@@ -0,0 +1,167 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <cstdlib>
+#include <cstring>
+#include "asset_pack_test.hpp"
+#include "../painter.hpp"
+#include "../image/asset_writer.hpp"
+#include "../image/rle_encoder.hpp"
+
+using namespace modm::ges;
+
+namespace
+{
+
+Surface<PixelFormat::RGB565>::Buffer<13, 7> logo;
+Surface<PixelFormat::L4>::Buffer<10, 5> icon;
+Surface<PixelFormat::RGB565>::Buffer<40, 6> sprite;
+const uint8_t font[] = {1, 2, 3, 4, 5};
+
+// the pack must be 4 byte aligned
+uint32_t pack[256];
+std::size_t size;
+
+} // anonymous namespace
+
+void
+AssetPackTest::setUp()
+{
+	std::srand(31);
+	Surface<PixelFormat::RGB565> logoSurface(logo), spriteSurface(sprite);
+	Surface<PixelFormat::L4> iconSurface(icon);
+	for (uint16_t y = 0; y < 7; y++)
+		for (uint16_t x = 0; x < 13; x++)
+			logoSurface.setPixel(x, y, ColorRGB565(uint16_t(std::rand())));
+	for (uint16_t y = 0; y < 5; y++)
+		for (uint16_t x = 0; x < 10; x++)
+			iconSurface.setPixel(x, y, ColorL4(uint8_t(std::rand() % 16)));
+	spriteSurface.clear(ColorRGB565(kColorBlack));
+	Painter<PixelFormat::RGB565>(spriteSurface).fillCircle(Circle(20, 3, 3), kColorRed);
+
+	AssetWriter writer;
+	writer.add("logo", logo);
+	writer.add("icon", icon);
+	writer.add<PixelFormat::RGB565>("sprite", spriteSurface.getSize(),
+			RleEncoder<PixelFormat::RGB565>::encode(spriteSurface, ColorRGB565(kColorBlack)));
+	writer.add("font", font, sizeof(font));
+	// names use all characters without termination
+	writer.add("sixteen_letters_", font, 1);
+
+	const std::vector<uint8_t> data = writer.write();
+	size = data.size();
+	std::memcpy(pack, data.data(), std::min(size, sizeof(pack)));
+}
+
+void
+AssetPackTest::testIndex()
+{
+	TEST_ASSERT_TRUE(size <= sizeof(pack));
+	const AssetPack assets(reinterpret_cast<const uint8_t*>(pack), size);
+	TEST_ASSERT_TRUE(assets.isValid());
+	TEST_ASSERT_EQUALS(assets.getCount(), 5);
+
+	TEST_ASSERT_EQUALS(assets.find("logo"), 0);
+	TEST_ASSERT_EQUALS(assets.find("icon"), 1);
+	TEST_ASSERT_EQUALS(assets.find("sprite"), 2);
+	TEST_ASSERT_EQUALS(assets.find("font"), 3);
+	TEST_ASSERT_EQUALS(assets.find("sixteen_letters_"), 4);
+	TEST_ASSERT_EQUALS(assets.find("sixteen"), -1);
+	TEST_ASSERT_EQUALS(assets.find("missing"), -1);
+
+	TEST_ASSERT_TRUE(assets.getSize(0) == Size(13, 7));
+	TEST_ASSERT_TRUE(assets.getSize(1) == Size(10, 5));
+	TEST_ASSERT_TRUE(assets.getPixelFormat(0) == PixelFormat::RGB565);
+	TEST_ASSERT_TRUE(assets.getPixelFormat(1) == PixelFormat::L4);
+	TEST_ASSERT_TRUE(assets.getEntry(0).encoding == AssetPack::Encoding::Raw);
+	TEST_ASSERT_TRUE(assets.getEntry(2).encoding == AssetPack::Encoding::Rle);
+	TEST_ASSERT_TRUE(assets.getEntry(3).encoding == AssetPack::Encoding::Data);
+	TEST_ASSERT_EQUALS(assets.getEntry(0).size, logo.getLength());
+	TEST_ASSERT_EQUALS(assets.getEntry(3).size, sizeof(font));
+
+	for (uint16_t ii = 0; ii < assets.getCount(); ii++)
+		TEST_ASSERT_EQUALS(assets.getEntry(ii).offset % AssetPack::Alignment, 0u);
+
+	// names longer than an entry are rejected
+	AssetWriter writer;
+	TEST_ASSERT_FALSE(writer.add("seventeen_letters", font, 1));
+}
+
+void
+AssetPackTest::testViews()
+{
+	const AssetPack assets(reinterpret_cast<const uint8_t*>(pack), size);
+
+	// the surfaces read the pixels in place
+	const Surface<PixelFormat::RGB565> logoView = assets.getSurface<PixelFormat::RGB565>(0);
+	TEST_ASSERT_TRUE(logoView.getSize() == Size(13, 7));
+	TEST_ASSERT_EQUALS(std::memcmp(assets.getData(0), logo.getData(), logo.getLength()), 0);
+	const Surface<PixelFormat::RGB565> logoSurface(logo);
+	uint16_t wrong = 0;
+	for (uint16_t y = 0; y < 7; y++)
+		for (uint16_t x = 0; x < 13; x++)
+			wrong += not (logoView.getPixel(x, y) == logoSurface.getPixel(x, y));
+	TEST_ASSERT_EQUALS(wrong, 0);
+
+	const Surface<PixelFormat::L4> iconView = assets.getSurface<PixelFormat::L4>(1);
+	const Surface<PixelFormat::L4> iconSurface(icon);
+	TEST_ASSERT_TRUE(iconView.getSize() == Size(10, 5));
+	for (uint16_t y = 0; y < 5; y++)
+		for (uint16_t x = 0; x < 10; x++)
+			wrong += not (iconView.getPixel(x, y) == iconSurface.getPixel(x, y));
+	TEST_ASSERT_EQUALS(wrong, 0);
+
+	// the encoded sprite draws like the original
+	static Surface<PixelFormat::RGB565>::Buffer<40, 6> drawn;
+	Surface<PixelFormat::RGB565> drawnSurface(drawn);
+	drawnSurface.clear(ColorRGB565(kColorBlack));
+	const RleImage<PixelFormat::RGB565> spriteView = assets.getRleImage<PixelFormat::RGB565>(2);
+	TEST_ASSERT_TRUE(spriteView.getSize() == Size(40, 6));
+	Painter<PixelFormat::RGB565>(drawnSurface).drawImage(spriteView, Point(0, 0));
+	TEST_ASSERT_EQUALS(std::memcmp(drawn.getData(), sprite.getData(), sprite.getLength()), 0);
+
+	TEST_ASSERT_EQUALS_ARRAY(assets.getData(3), font, sizeof(font));
+
+	// views of another format or encoding are empty
+	TEST_ASSERT_TRUE(assets.getSurface<PixelFormat::RGB332>(0).getSize() == Size(0, 0));
+	TEST_ASSERT_TRUE(assets.getSurface<PixelFormat::RGB565>(2).getSize() == Size(0, 0));
+	TEST_ASSERT_TRUE(assets.getRleImage<PixelFormat::RGB565>(0).getSize() == Size(0, 0));
+	TEST_ASSERT_TRUE(assets.getSurface<PixelFormat::RGB565>(5).getSize() == Size(0, 0));
+}
+
+void
+AssetPackTest::testValidation()
+{
+	const uint8_t *data = reinterpret_cast<const uint8_t*>(pack);
+	TEST_ASSERT_FALSE(AssetPack(nullptr, size).isValid());
+	TEST_ASSERT_FALSE(AssetPack().isValid());
+	TEST_ASSERT_EQUALS(AssetPack().getCount(), 0);
+
+	// the index and the data must be complete
+	TEST_ASSERT_FALSE(AssetPack(data, sizeof(AssetPack::Header) + sizeof(AssetPack::Entry)).isValid());
+	TEST_ASSERT_FALSE(AssetPack(data, size - 1).isValid());
+
+	// unaligned data
+	static uint32_t shifted[257];
+	std::memcpy(reinterpret_cast<uint8_t*>(shifted) + 1, pack, size);
+	TEST_ASSERT_FALSE(AssetPack(reinterpret_cast<const uint8_t*>(shifted) + 1, size).isValid());
+
+	// wrong magic and version
+	static uint32_t copy[256];
+	std::memcpy(copy, pack, size);
+	copy[0] ^= 1;
+	TEST_ASSERT_FALSE(AssetPack(reinterpret_cast<const uint8_t*>(copy), size).isValid());
+	copy[0] ^= 1;
+	reinterpret_cast<AssetPack::Header*>(copy)->version++;
+	TEST_ASSERT_FALSE(AssetPack(reinterpret_cast<const uint8_t*>(copy), size).isValid());
+	reinterpret_cast<AssetPack::Header*>(copy)->version--;
+	TEST_ASSERT_TRUE(AssetPack(reinterpret_cast<const uint8_t*>(copy), size).isValid());
+
+	// raw images must hold all their pixels
+	reinterpret_cast<AssetPack::Entry*>(reinterpret_cast<uint8_t*>(copy) + sizeof(AssetPack::Header))->height++;
+	TEST_ASSERT_FALSE(AssetPack(reinterpret_cast<const uint8_t*>(copy), size).isValid());
+}
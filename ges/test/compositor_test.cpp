@@ -0,0 +1,184 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <cstring>
+#include "compositor_test.hpp"
+#include "../compositor.hpp"
+
+using namespace modm::ges;
+
+namespace
+{
+
+using Output = Surface<PixelFormat::RGB565>;
+
+Output::Buffer<64, 48> outputBuffer, referenceBuffer;
+Output::Buffer<20, 20> redBuffer;
+Surface<PixelFormat::ARGB8>::Buffer<16, 16> greenBuffer;
+
+const ColorRGB565 black(kColorBlack);
+const ColorRGB565 red(kColorRed);
+const ColorRGB565 green(kColorLime);
+
+// the number of pixels of the area which have the color
+uint16_t
+count(const Output &surface, const Rect &area, const ColorRGB565 color)
+{
+	uint16_t pixels = 0;
+	for (int16_t y = area.getTop(); y <= int16_t(area.getBottom()); y++)
+		for (int16_t x = area.getLeft(); x <= int16_t(area.getRight()); x++)
+			pixels += (surface.getPixel(x, y) == color);
+	return pixels;
+}
+
+} // anonymous namespace
+
+void
+CompositorTest::testLayerOrder()
+{
+	Output output(outputBuffer);
+	Output redSurface(redBuffer);
+	Surface<PixelFormat::ARGB8> greenSurface(greenBuffer);
+	redSurface.clear(red);
+	greenSurface.clear(PixelColor<PixelFormat::ARGB8>(kColorLime));
+
+	Compositor<PixelFormat::RGB565, 2> compositor(output);
+	TEST_ASSERT_EQUALS(compositor.addLayer(redSurface, Point(5, 5)), 0);
+	TEST_ASSERT_EQUALS(compositor.addLayer(greenSurface, Point(15, 15)), 1);
+	TEST_ASSERT_EQUALS(compositor.addLayer(redSurface, Point(0, 0)), -1);
+	TEST_ASSERT_EQUALS(compositor.getLayerCount(), 2);
+	TEST_ASSERT_TRUE(compositor.compose());
+
+	// the upper layer covers the overlap, the background is everywhere else
+	TEST_ASSERT_EQUALS(count(output, Rect(5, 5, 19, 19), red), 20 * 20 - 10 * 10);
+	TEST_ASSERT_EQUALS(count(output, Rect(15, 15, 15, 15), green), 16 * 16);
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), black), 64 * 48 - 20 * 20 - 16 * 16 + 10 * 10);
+
+	// hidden layers are not composed
+	compositor.setVisible(1, false);
+	TEST_ASSERT_TRUE(compositor.compose());
+	TEST_ASSERT_EQUALS(count(output, Rect(5, 5, 19, 19), red), 20 * 20);
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), green), 0);
+
+	// moving a layer recomposes its old and new area
+	compositor.setVisible(1, true);
+	compositor.setPosition(1, Point(40, 30));
+	TEST_ASSERT_TRUE(compositor.compose());
+	TEST_ASSERT_EQUALS(count(output, Rect(5, 5, 19, 19), red), 20 * 20);
+	TEST_ASSERT_EQUALS(count(output, Rect(40, 30, 15, 15), green), 16 * 16);
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), black), 64 * 48 - 20 * 20 - 16 * 16);
+}
+
+void
+CompositorTest::testOpacity()
+{
+	Output output(outputBuffer), reference(referenceBuffer);
+	Output redSurface(redBuffer);
+	redSurface.clear(red);
+
+	Compositor<PixelFormat::RGB565> compositor(output, kColorBlue);
+	compositor.addLayer(redSurface, Point(10, 10), 100);
+	compositor.compose();
+
+	// the layer is blended like an image drawn with the same opacity
+	Painter<PixelFormat::RGB565> painter(reference);
+	reference.clear(ColorRGB565(kColorBlue));
+	painter.drawImage(redSurface, redSurface.getBounds(), Point(10, 10), 100, painter.AoverB);
+	TEST_ASSERT_EQUALS(std::memcmp(outputBuffer.getData(), referenceBuffer.getData(), outputBuffer.getLength()), 0);
+	TEST_ASSERT_EQUALS(count(output, Rect(10, 10, 19, 19), red), 0);
+
+	// fully transparent layers leave the background
+	compositor.setOpacity(0, 0);
+	compositor.compose();
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), ColorRGB565(kColorBlue)), 64 * 48);
+
+	compositor.setOpacity(0, 0xff);
+	compositor.compose();
+	TEST_ASSERT_EQUALS(count(output, Rect(10, 10, 19, 19), red), 20 * 20);
+}
+
+void
+CompositorTest::testDamage()
+{
+	Output output(outputBuffer);
+	Output redSurface(redBuffer);
+
+	// everything is damaged initially
+	Compositor<PixelFormat::RGB565> compositor(output);
+	TEST_ASSERT_TRUE(compositor.getDamage().contains(0, 0));
+	TEST_ASSERT_TRUE(compositor.getDamage().contains(63, 47));
+	compositor.addLayer(redSurface, Point(10, 10));
+	TEST_ASSERT_TRUE(compositor.compose());
+	TEST_ASSERT_TRUE(compositor.getDamage().isEmpty());
+	TEST_ASSERT_FALSE(compositor.compose());
+
+	// unchanged properties damage nothing
+	compositor.setOpacity(0, 0xff);
+	compositor.setVisible(0, true);
+	TEST_ASSERT_TRUE(compositor.getDamage().isEmpty());
+
+	// moving damages the old and the new area
+	compositor.setPosition(0, Point(30, 20));
+	const Region &damage = compositor.getDamage();
+	TEST_ASSERT_TRUE(damage.contains(10, 10));
+	TEST_ASSERT_TRUE(damage.contains(29, 29));
+	TEST_ASSERT_TRUE(damage.contains(30, 20));
+	TEST_ASSERT_TRUE(damage.contains(49, 39));
+	TEST_ASSERT_FALSE(damage.contains(40, 10));
+	TEST_ASSERT_FALSE(damage.contains(50, 40));
+	compositor.compose();
+
+	// invalidated areas are in layer coordinates and clipped to the layer
+	compositor.invalidate(0, Rect(15, 15, 10, 10));
+	TEST_ASSERT_TRUE(damage.contains(45, 35));
+	TEST_ASSERT_TRUE(damage.contains(49, 39));
+	TEST_ASSERT_FALSE(damage.contains(50, 40));
+	TEST_ASSERT_FALSE(damage.contains(44, 35));
+	compositor.compose();
+
+	// and to the output
+	compositor.setPosition(0, Point(60, 40));
+	compositor.compose();
+	compositor.invalidate(0);
+	TEST_ASSERT_TRUE(damage.getBounds().getBottomRight() == Point(63, 47));
+	compositor.compose();
+	compositor.invalidate(0, Rect(10, 10, 5, 5));
+	TEST_ASSERT_TRUE(damage.isEmpty());
+}
+
+void
+CompositorTest::testComposeClipping()
+{
+	Output output(outputBuffer);
+	Output redSurface(redBuffer);
+	redSurface.clear(red);
+
+	Compositor<PixelFormat::RGB565> compositor(output);
+	compositor.addLayer(redSurface, Point(10, 10));
+	compositor.compose();
+
+	// pixels outside of the damage are not composed again
+	output.setPixel(0, 0, green);
+	output.setPixel(12, 12, green);
+	output.setPixel(28, 25, green);
+	redSurface.fillSpan(15, 10, 17, ColorRGB565(kColorWhite));
+	compositor.invalidate(0, Rect(10, 14, 9, 2));
+	TEST_ASSERT_TRUE(compositor.compose());
+
+	TEST_ASSERT_TRUE(output.getPixel(0, 0) == green);
+	TEST_ASSERT_TRUE(output.getPixel(12, 12) == green);
+	TEST_ASSERT_TRUE(output.getPixel(28, 25) == red);
+	TEST_ASSERT_EQUALS(count(output, Rect(20, 25, 7, 0), ColorRGB565(kColorWhite)), 8);
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), ColorRGB565(kColorWhite)), 8);
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), green), 2);
+
+	// invalidating everything recomposes the whole output
+	compositor.invalidate();
+	compositor.compose();
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), green), 0);
+	TEST_ASSERT_EQUALS(count(output, output.getBounds(), black), 64 * 48 - 20 * 20);
+}
@@ -0,0 +1,144 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <cstring>
+#include "frame_test.hpp"
+#include "../frame.hpp"
+
+using namespace modm::ges;
+
+namespace
+{
+
+using NativeSurface = Surface<PixelFormat::RGB565>;
+
+NativeSurface::Buffer<64, 32> buffer, imageBuffer;
+
+const ColorRGB565 background(kColorNavy);
+const ColorRGB565 marker(kColorYellow);
+
+uint16_t
+count(const NativeSurface &surface, const ColorRGB565 color)
+{
+	uint16_t pixels = 0;
+	for (int16_t y = 0; y < surface.getHeight(); y++)
+		for (int16_t x = 0; x < surface.getWidth(); x++)
+			pixels += (surface.getPixel(x, y) == color);
+	return pixels;
+}
+
+} // anonymous namespace
+
+void
+FrameTest::testClear()
+{
+	NativeSurface surface(buffer);
+	Painter<PixelFormat::RGB565> painter(surface);
+	surface.clear(marker);
+	{
+		Frame<PixelFormat::RGB565> frame(painter, background);
+		TEST_ASSERT_TRUE(painter.getDamage() == &frame.getDamage());
+
+		// the first frame clears everything
+		frame.clear();
+		TEST_ASSERT_EQUALS(count(surface, background), 64 * 32);
+		TEST_ASSERT_TRUE(frame.getDamage().isEmpty());
+
+		// the drawn primitives are cleared again
+		painter.fillRect(Rect(2, 3, 9, 4), kColorRed);
+		painter.drawLine(Line(Point(20, 1), Point(30, 11)), kColorRed);
+		painter.fillCircle(Circle(50, 25, 5), kColorRed);
+		TEST_ASSERT_TRUE(frame.getDamage().contains(2, 3));
+		TEST_ASSERT_TRUE(frame.getDamage().contains(30, 11));
+		frame.clear();
+		TEST_ASSERT_EQUALS(count(surface, background), 64 * 32);
+
+		// clipped primitives only damage what they could have changed
+		painter.setClipArea(Rect(0, 0, 9, 9));
+		painter.fillRect(Rect(5, 5, 20, 20), kColorRed);
+		TEST_ASSERT_TRUE(frame.getDamage().contains(9, 9));
+		TEST_ASSERT_FALSE(frame.getDamage().contains(10, 10));
+		painter.resetClipArea();
+		frame.clear();
+
+		// pixels set outside the painter must be damaged explicitly
+		surface.setPixel(40, 4, marker);
+		surface.setPixel(41, 4, marker);
+		frame.damage(Rect(40, 4, 0, 0));
+		frame.clear();
+		TEST_ASSERT_TRUE(surface.getPixel(40, 4) == background);
+		TEST_ASSERT_TRUE(surface.getPixel(41, 4) == marker);
+		surface.setPixel(41, 4, background);
+
+		// areas outside of the surface are ignored
+		frame.damage(Rect(70, 40, 5, 5));
+		TEST_ASSERT_TRUE(frame.getDamage().isEmpty());
+	}
+	// the painter stops recording into a destroyed frame
+	TEST_ASSERT_TRUE(painter.getDamage() == nullptr);
+}
+
+void
+FrameTest::testThreshold()
+{
+	NativeSurface surface(buffer);
+	Painter<PixelFormat::RGB565> painter(surface);
+	Frame<PixelFormat::RGB565> frame(painter, background, 128);
+	frame.clear();
+
+	// up to half of the surface only the damage is cleared, undamaged pixels stay
+	surface.setPixel(63, 31, marker);
+	painter.fillRect(Rect(0, 0, 31, 31), kColorRed);
+	frame.clear();
+	TEST_ASSERT_TRUE(surface.getPixel(63, 31) == marker);
+	TEST_ASSERT_EQUALS(count(surface, background), 64 * 32 - 1);
+
+	// above it the whole surface is cleared at once
+	painter.fillRect(Rect(0, 0, 31, 31), kColorRed);
+	const Point point(40, 0);
+	painter.drawPoints(&point, 1, kColorRed);
+	frame.clear();
+	TEST_ASSERT_TRUE(surface.getPixel(63, 31) == background);
+	TEST_ASSERT_EQUALS(count(surface, background), 64 * 32);
+
+	// as well as after invalidating
+	surface.setPixel(63, 31, marker);
+	frame.invalidate();
+	frame.clear();
+	TEST_ASSERT_TRUE(surface.getPixel(63, 31) == background);
+
+	// a zero threshold always clears everything
+	Frame<PixelFormat::RGB565> full(painter, background, 0);
+	full.clear();
+	surface.setPixel(63, 31, marker);
+	painter.drawPoints(&point, 1, kColorRed);
+	full.clear();
+	TEST_ASSERT_TRUE(surface.getPixel(63, 31) == background);
+}
+
+void
+FrameTest::testRestoreImage()
+{
+	NativeSurface surface(buffer), image(imageBuffer);
+	Painter<PixelFormat::RGB565> painter(surface);
+	for (int16_t y = 0; y < 32; y++)
+		for (int16_t x = 0; x < 64; x++)
+			image.setPixel(x, y, ColorRGB565(Color(x * 4, y * 8, 128)));
+
+	for (const uint8_t threshold : {uint8_t(0), uint8_t(128), uint8_t(255)})
+	{
+		Frame<PixelFormat::RGB565> frame(painter, image, threshold);
+		frame.clear();
+		TEST_ASSERT_EQUALS(std::memcmp(buffer.getData(), imageBuffer.getData(), buffer.getLength()), 0);
+
+		painter.fillRect(Rect(-5, 20, 20, 30), kColorRed);
+		painter.drawCircle(Circle(40, 10, 12), kColorRed);
+		painter.drawImage(image, Rect(0, 0, 10, 10), Point(50, 0));
+		frame.clear();
+		TEST_ASSERT_EQUALS(std::memcmp(buffer.getData(), imageBuffer.getData(), buffer.getLength()), 0);
+	}
+}
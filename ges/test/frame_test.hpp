@@ -0,0 +1,21 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <unittest/testsuite.hpp>
+
+class FrameTest : public unittest::TestSuite
+{
+public:
+	void
+	testClear();
+
+	void
+	testThreshold();
+
+	void
+	testRestoreImage();
+};
@@ -0,0 +1,335 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <cstdlib>
+#include <cstring>
+#include "painter_test.hpp"
+#include "../painter.hpp"
+
+using namespace modm::ges;
+
+namespace
+{
+
+// The ellipse rasterizers of the first release, which used 64bit and floating
+// point error terms for odd ellipses. Pixels are set directly, the surface
+// must contain the whole ellipse.
+class BaselineEllipse
+{
+public:
+	BaselineEllipse(Surface<PixelFormat::L1> &surface) :
+		surface(surface)
+	{}
+
+	void
+	draw(const Ellipse &ellipse, bool fill)
+	{
+		if (ellipse.isNull()) plot(ellipse.getX(), ellipse.getY());
+		else if (ellipse.isEven()) drawEven(ellipse, fill);
+		else drawOdd(ellipse, fill);
+	}
+
+private:
+	void
+	plot(int16_t x, int16_t y)
+	{
+		if (x >= 0 and y >= 0 and x < surface.getWidth() and y < surface.getHeight())
+			surface.setPixel(x, y, ColorL1(kColorWhite));
+	}
+
+	void
+	span(int16_t y, int16_t beginX, int16_t endX)
+	{
+		for (int16_t xx = beginX; xx <= endX; xx++) plot(xx, y);
+	}
+
+	void
+	drawEven(const Ellipse &ellipse, bool fill)
+	{
+		int16_t a = ellipse.getWidth() / 2;
+		int16_t b = ellipse.getHeight() / 2;
+
+		int32_t x = -a, y = 0;
+		int32_t e2 = b, dx = (1+2*x)*e2*e2;
+		int32_t dy = x*x, err = dx+dy;
+		int16_t xm = ellipse.getX() + a;
+		int16_t ym = ellipse.getY() + b;
+
+		do {
+			if (fill)
+			{
+				span(ym+y, xm+x, xm-x);
+				span(ym-y, xm+x, xm-x);
+			}
+			else
+			{
+				plot(xm-x, ym+y);
+				plot(xm+x, ym+y);
+				plot(xm+x, ym-y);
+				plot(xm-x, ym-y);
+			}
+			e2 = 2*err;
+			if (e2 >= dx) { x++; err += dx += 2*int32_t(b)*b; }
+			if (e2 <= dy) { y++; err += dy += 2*int32_t(a)*a; }
+		}
+		while (x <= 0);
+
+		// the upper tip was drawn as an inverted, empty line
+		while (y++ < b)
+		{
+			plot(xm, ym+y);
+			plot(xm, ym-y);
+		}
+	}
+
+	void
+	drawOdd(const Ellipse &ellipse, bool fill)
+	{
+		int16_t x0 = ellipse.getX();
+		int16_t y0 = ellipse.getY();
+		int16_t x1 = x0 + ellipse.getWidth();
+		int16_t y1 = y0 + ellipse.getHeight();
+
+		int32_t a = std::abs(x1-x0), b = std::abs(y1-y0), b1 = b & 1;
+		int64_t dx = 4*(1.0-a)*b*b, dy = 4*(b1+1)*a*a;
+		int64_t err = dx+dy+b1*a*a, e2;
+
+		y0 += (b+1)/2; y1 = y0-b1;
+		a = 8*a*a; b1 = 8*b*b;
+
+		do
+		{
+			if (fill)
+			{
+				span(y0, x0, x1);
+				span(y1, x0, x1);
+			}
+			else
+			{
+				plot(x1, y0);
+				plot(x0, y0);
+				plot(x0, y1);
+				plot(x1, y1);
+			}
+			e2 = 2*err;
+			if (e2 <= dy) { ++y0; --y1; err += dy += a; }
+			if (e2 >= dx || 2*err > dy) { ++x0; --x1; err += dx += b1; }
+		}
+		while (x0 <= x1);
+
+		while (y0-y1 <= b)
+		{
+			if (fill)
+			{
+				span(y0, x0-1, x1+1);
+				span(y1, x0-1, x1+1);
+			}
+			else
+			{
+				plot(x0-1, y0);
+				plot(x1+1, y0);
+				plot(x0-1, y1);
+				plot(x1+1, y1);
+			}
+			++y0; --y1;
+		}
+	}
+
+	Surface<PixelFormat::L1> &surface;
+};
+
+// gives access to the limits of the 32bit error terms
+class EllipsePainter : public Painter<PixelFormat::L1>
+{
+public:
+	using Painter::EvenEllipseLimit;
+	using Painter::OddEllipseLimit;
+};
+
+// Saves random areas, partially outside of the surface, draws over them and
+// restores them. Returns the number of areas not restored exactly or whose
+// pixels did not fit into `getSaveSize()` bytes.
+template< PixelFormat Format, typename... Options >
+uint16_t
+roundTripSaveUnder(Options... options)
+{
+	constexpr uint16_t Width = 37, Height = 21;
+	static uint8_t buffer[Width * Height * 2], original[sizeof(buffer)], saved[64 * 64 * 2 + 1];
+	Surface<Format> surface(buffer, Width, Height, options...);
+	Painter<Format> painter(surface);
+	for (std::size_t ii = 0; ii < sizeof(buffer); ii++) buffer[ii] = std::rand();
+
+	uint16_t errors = 0;
+	for (uint16_t ii = 0; ii < 500; ii++)
+	{
+		const Rect area(std::rand() % 60 - 10, std::rand() % 40 - 10, std::rand() % 50, std::rand() % 30);
+		const std::size_t size = painter.getSaveSize(area);
+		std::memset(saved, 0xa5, sizeof(saved));
+		std::memcpy(original, buffer, sizeof(buffer));
+
+		painter.saveUnder(area, saved);
+		// the clip area does not apply to restoring
+		if (ii & 1) painter.setClipArea(Rect(std::rand() % 20, std::rand() % 10, std::rand() % 30, std::rand() % 20));
+		painter.fillRect(area, Color(std::rand() % 256, std::rand() % 256, std::rand() % 256));
+		painter.drawLine(Line(area.getTopLeft(), area.getBottomRight()), kColorRed);
+		painter.restoreUnder(area, saved);
+		painter.resetClipArea();
+
+		errors += (saved[size] != 0xa5) or std::memcmp(original, buffer, sizeof(buffer));
+		std::memcpy(buffer, original, sizeof(buffer));
+	}
+	return errors;
+}
+
+} // anonymous namespace
+
+void
+PainterTest::testOverdraw()
+{
+	// requires MODM_GES_DEBUG_OVERDRAW, which the unittest configuration defines
+	static Surface<PixelFormat::RGB565>::Buffer<200, 200> buffer;
+	static uint8_t counters[200 * 200];
+	Surface<PixelFormat::RGB565> surface(buffer);
+	Painter<PixelFormat::RGB565> painter(surface);
+	painter.setWriteCounters(counters);
+
+	const Color color(10, 20, 30, 100);
+	uint32_t written = 0, overdrawn = 0;
+	std::srand(42);
+	for (uint16_t ii = 0; ii < 3000; ii++)
+	{
+		std::memset(counters, 0, sizeof(counters));
+		Region region(Rect(std::rand() % 100, std::rand() % 100, std::rand() % 120, std::rand() % 120));
+		region.subtract(Rect(std::rand() % 150, std::rand() % 150, std::rand() % 40, std::rand() % 40));
+		if (ii & 1) painter.setClipRegion(region);
+		else painter.resetClipArea();
+
+		const Circle circle(std::rand() % 200, std::rand() % 200, std::rand() % 100 + 1);
+		const Rect rect(std::rand() % 200 - 50, std::rand() % 200 - 50, std::rand() % 150, std::rand() % 150);
+		const angle_t start(std::rand() % 700 / 100.f), end(std::rand() % 700 / 100.f);
+		switch (ii % 6)
+		{
+			case 0: painter.fillCircle(circle, color, painter.AoverB); break;
+			case 1: painter.fillEllipse(Ellipse(rect.getTopLeft(), rect.getSize()), color, painter.AoverB); break;
+			case 2: painter.fillRoundedRect(RoundedRect(rect, std::rand() % 40), color, painter.Plus); break;
+			case 3: painter.fillPie(circle, start, end, color, painter.Plus); break;
+			case 4: painter.fillRing(circle, std::rand() % 60, start, end, color, painter.Plus); break;
+			case 5: painter.fillRect(rect, color, painter.Plus); break;
+		}
+		for (const uint8_t count : counters)
+		{
+			written += count;
+			overdrawn += (count > 1);
+		}
+	}
+	// every pixel inside a filled primitive is written exactly once
+	TEST_ASSERT_TRUE(written > 0);
+	TEST_ASSERT_EQUALS(overdrawn, 0u);
+}
+
+void
+PainterTest::testEllipseBaseline()
+{
+	// the whole ellipse is compared, up to beyond the largest one using 32bit errors
+	static Surface<PixelFormat::L1>::Buffer<1440, 1440> buffer, bufferBaseline;
+	Surface<PixelFormat::L1> surface(buffer), surfaceBaseline(bufferBaseline);
+	Painter<PixelFormat::L1> painter(surface);
+	BaselineEllipse baseline(surfaceBaseline);
+
+	auto compare = [&](int16_t width, int16_t height)
+	{
+		const Ellipse ellipse(Point(0, 0), Size(width, height));
+		for (const bool fill : {false, true})
+		{
+			surface.clear();
+			surfaceBaseline.clear();
+			if (fill) painter.fillEllipse(ellipse, kColorWhite);
+			else      painter.drawEllipse(ellipse, kColorWhite);
+			baseline.draw(ellipse, fill);
+			TEST_ASSERT_EQUALS(std::memcmp(buffer.getData(), bufferBaseline.getData(), buffer.getLength()), 0);
+		}
+	};
+
+	// the even baseline used 32bit errors itself
+	const int16_t even = EllipsePainter::EvenEllipseLimit & ~1;
+	for (int16_t width = 2; width <= even; width += (width < even - 80) ? 74 : 2)
+	{
+		for (int16_t height = 2; height <= even; height += (height < even - 80) ? 148 : 8)
+			compare(width, height);
+		compare(width, even);
+	}
+
+	const int16_t odd = EllipsePainter::OddEllipseLimit + 8;
+	for (int16_t width = 1; width <= odd; width += (width < odd - 48) ? 37 : 1)
+	{
+		for (int16_t height = 1; height <= odd; height += (height < odd - 48) ? 73 : 5)
+			if ((width | height) & 1) compare(width, height);
+		compare(width, odd - 9);
+		compare(width, odd - 8);
+		compare(width, odd);
+	}
+}
+
+void
+PainterTest::testPolyline()
+{
+	static Surface<PixelFormat::L8>::Buffer<16, 16> buffer;
+	Surface<PixelFormat::L8> surface(buffer);
+	Painter<PixelFormat::L8> painter(surface);
+
+	// every pixel is added once, a pixel drawn twice is brighter
+	const uint8_t once = ColorL8(Color(40, 40, 40)).getValue();
+	auto draw = [&](const Point *points, std::size_t count) -> uint16_t
+	{
+		surface.clear();
+		painter.drawPolyline(points, count, Color(40, 40, 40), painter.Plus);
+		uint16_t written = 0;
+		for (int16_t y = 0; y < 16; y++)
+		{
+			for (int16_t x = 0; x < 16; x++)
+			{
+				const uint8_t value = surface.getPixel(x, y).getValue();
+				TEST_ASSERT_TRUE(value == 0 or value == once);
+				written += (value != 0);
+			}
+		}
+		return written;
+	};
+
+	// any number of identical points is a single pixel
+	const Point same[] = {Point(3, 4), Point(3, 4), Point(3, 4), Point(3, 4), Point(3, 4)};
+	for (std::size_t count = 1; count <= 5; count++)
+		TEST_ASSERT_EQUALS(draw(same, count), 1u);
+
+	const Point open[] = {Point(2, 2), Point(2, 2), Point(7, 2), Point(7, 2)};
+	TEST_ASSERT_EQUALS(draw(open, 4), 6u);
+
+	// the closing vertex is drawn by the first segment, even if it is repeated
+	const Point closed[] = {Point(2, 2), Point(7, 2), Point(7, 7), Point(2, 7), Point(2, 2), Point(2, 2)};
+	TEST_ASSERT_EQUALS(draw(closed, 5), 20u);
+	TEST_ASSERT_EQUALS(draw(closed, 6), 20u);
+
+	const Point diagonal[] = {Point(1, 1), Point(9, 5), Point(4, 12), Point(1, 1)};
+	TEST_ASSERT_TRUE(draw(diagonal, 4) > 0);
+}
+
+void
+PainterTest::testSaveUnder()
+{
+	std::srand(50);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::L1>(), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::L1>(PixelOrder::MsbFirst), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::L1>(PixelOrder::Pages), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::L1>(PixelOrder::Pages, Orientation::Rotate90), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::AL1>(PixelOrder::MsbFirst), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::L2>(), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::L4>(PixelOrder::LsbFirst, Orientation::Rotate180), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::ARGB1>(), 0);
+	// and a few unpacked formats
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::RGB332>(), 0);
+	TEST_ASSERT_EQUALS(roundTripSaveUnder<PixelFormat::RGB565>(Orientation::Rotate270), 0);
+}
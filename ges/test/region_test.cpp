@@ -0,0 +1,235 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <cstdlib>
+#include <cstring>
+#include "region_test.hpp"
+#include "../geometry/region.hpp"
+
+using namespace modm::ges;
+
+namespace
+{
+
+constexpr int16_t Width = 64;
+constexpr int16_t Height = 48;
+
+// the region as one flag per pixel, all rectangles must be inside
+struct Mask
+{
+	bool pixels[Height][Width];
+
+	Mask()
+	{ std::memset(pixels, 0, sizeof(pixels)); }
+
+	Mask(const Region &region) : Mask()
+	{
+		for (uint8_t ii = 0; ii < region.getRectCount(); ii++)
+		{
+			const Rect rect = region.getRect(ii);
+			for (int16_t y = rect.getTop(); y <= int16_t(rect.getBottom()); y++)
+				for (int16_t x = rect.getLeft(); x <= int16_t(rect.getRight()); x++)
+					pixels[y][x] = true;
+		}
+	}
+};
+
+// the rectangles do not overlap and are sorted into bands
+bool
+isBanded(const Region &region)
+{
+	uint32_t area = 0;
+	for (uint8_t ii = 0; ii < region.getRectCount(); ii++)
+	{
+		const Rect rect = region.getRect(ii);
+		area += (uint32_t(rect.getWidth()) + 1) * (uint32_t(rect.getHeight()) + 1);
+		if (ii == 0) continue;
+
+		const Rect previous = region.getRect(ii - 1);
+		if (rect.getTop() == previous.getTop())
+		{
+			if (rect.getBottom() != previous.getBottom()) return false;
+			if (rect.getLeft() <= previous.getRight() + 1) return false;
+		}
+		else if (rect.getTop() <= previous.getBottom()) return false;
+	}
+
+	uint32_t covered = 0;
+	const Mask mask(region);
+	for (int16_t y = 0; y < Height; y++)
+		for (int16_t x = 0; x < Width; x++)
+			covered += mask.pixels[y][x];
+	return area == covered;
+}
+
+bool
+isSame(const Rect &a, const Rect &b)
+{ return a.getOrigin() == b.getOrigin() and a.getSize() == b.getSize(); }
+
+bool
+isEqual(const Region &region, const Mask &mask)
+{
+	for (int16_t y = 0; y < Height; y++)
+		for (int16_t x = 0; x < Width; x++)
+			if (region.contains(x, y) != mask.pixels[y][x]) return false;
+	return true;
+}
+
+Rect
+randomRect()
+{
+	const int16_t x = std::rand() % Width, y = std::rand() % Height;
+	return Rect(x, y, std::rand() % (Width - x), std::rand() % (Height - y));
+}
+
+} // anonymous namespace
+
+void
+RegionTest::testUnion()
+{
+	Region region(Rect(0, 0, 9, 9));
+	TEST_ASSERT_TRUE(region.unite(Rect(5, 5, 9, 9)));
+	// one band above, one with the merged span and one below the overlap
+	TEST_ASSERT_EQUALS(region.getRectCount(), 3);
+	TEST_ASSERT_TRUE(region.contains(0, 0));
+	TEST_ASSERT_TRUE(region.contains(14, 14));
+	TEST_ASSERT_TRUE(region.contains(12, 7));
+	TEST_ASSERT_FALSE(region.contains(12, 2));
+	TEST_ASSERT_FALSE(region.contains(2, 12));
+	TEST_ASSERT_TRUE(isSame(region.getBounds(), Rect(0, 0, 14, 14)));
+	TEST_ASSERT_TRUE(isBanded(region));
+
+	// adjacent rectangles of the same columns are merged into one
+	Region column(Rect(3, 0, 4, 4));
+	TEST_ASSERT_TRUE(column.unite(Rect(3, 5, 4, 4)));
+	TEST_ASSERT_EQUALS(column.getRectCount(), 1);
+	TEST_ASSERT_TRUE(isSame(column.getRect(0), Rect(3, 0, 4, 9)));
+
+	// and so are adjacent spans within a band
+	Region row(Rect(0, 0, 4, 4));
+	TEST_ASSERT_TRUE(row.unite(Rect(5, 0, 4, 4)));
+	TEST_ASSERT_EQUALS(row.getRectCount(), 1);
+
+	Region empty;
+	TEST_ASSERT_TRUE(empty.unite(Rect(2, 3, 4, 5)));
+	TEST_ASSERT_TRUE(isSame(empty.getRect(0), Rect(2, 3, 4, 5)));
+}
+
+void
+RegionTest::testIntersection()
+{
+	Region region(Rect(0, 0, 9, 9));
+	TEST_ASSERT_TRUE(region.intersect(Rect(5, 5, 9, 9)));
+	TEST_ASSERT_EQUALS(region.getRectCount(), 1);
+	TEST_ASSERT_TRUE(isSame(region.getRect(0), Rect(5, 5, 4, 4)));
+
+	TEST_ASSERT_TRUE(region.intersect(Rect(20, 20, 3, 3)));
+	TEST_ASSERT_TRUE(region.isEmpty());
+
+	// two separate spans are cut by a rectangle across both
+	Region spans(Rect(0, 0, 4, 9));
+	TEST_ASSERT_TRUE(spans.unite(Rect(10, 0, 4, 9)));
+	TEST_ASSERT_TRUE(spans.intersect(Rect(2, 3, 10, 2)));
+	TEST_ASSERT_EQUALS(spans.getRectCount(), 2);
+	TEST_ASSERT_TRUE(isSame(spans.getRect(0), Rect(2, 3, 2, 2)));
+	TEST_ASSERT_TRUE(isSame(spans.getRect(1), Rect(10, 3, 2, 2)));
+	TEST_ASSERT_TRUE(spans.intersects(Rect(11, 4, 5, 5)));
+	TEST_ASSERT_FALSE(spans.intersects(Rect(5, 0, 4, 9)));
+}
+
+void
+RegionTest::testSubtraction()
+{
+	// a frame around a hole
+	Region region(Rect(0, 0, 9, 9));
+	TEST_ASSERT_TRUE(region.subtract(Rect(3, 3, 3, 3)));
+	TEST_ASSERT_EQUALS(region.getRectCount(), 4);
+	TEST_ASSERT_FALSE(region.contains(3, 3));
+	TEST_ASSERT_FALSE(region.contains(6, 6));
+	TEST_ASSERT_TRUE(region.contains(2, 4));
+	TEST_ASSERT_TRUE(region.contains(7, 4));
+	TEST_ASSERT_TRUE(region.contains(4, 7));
+	TEST_ASSERT_TRUE(isSame(region.getBounds(), Rect(0, 0, 9, 9)));
+	TEST_ASSERT_TRUE(isBanded(region));
+
+	// filling the hole again gives the original rectangle
+	TEST_ASSERT_TRUE(region.unite(Rect(3, 3, 3, 3)));
+	TEST_ASSERT_EQUALS(region.getRectCount(), 1);
+	TEST_ASSERT_TRUE(isSame(region.getRect(0), Rect(0, 0, 9, 9)));
+
+	TEST_ASSERT_TRUE(region.subtract(Rect(-5, -5, 20, 20)));
+	TEST_ASSERT_TRUE(region.isEmpty());
+}
+
+void
+RegionTest::testCapacity()
+{
+	// every other pixel of a row is a separate rectangle
+	Region region;
+	for (uint8_t ii = 0; ii < Region::Capacity; ii++)
+		TEST_ASSERT_TRUE(region.unite(Rect(2 * ii, 0, 0, 0)));
+	TEST_ASSERT_EQUALS(region.getRectCount(), Region::Capacity);
+
+	// a failed operation leaves the region unchanged
+	TEST_ASSERT_FALSE(region.unite(Rect(0, 2, 0, 0)));
+	TEST_ASSERT_EQUALS(region.getRectCount(), Region::Capacity);
+	TEST_ASSERT_FALSE(region.contains(0, 2));
+
+	// unless it falls back to the bounding rectangle
+	region.uniteOrBound(Rect(0, 2, 0, 0));
+	TEST_ASSERT_EQUALS(region.getRectCount(), 1);
+	TEST_ASSERT_TRUE(isSame(region.getRect(0), Rect(0, 0, 2 * Region::Capacity - 2, 2)));
+}
+
+void
+RegionTest::testRandom()
+{
+	std::srand(28);
+	for (uint16_t ii = 0; ii < 500; ii++)
+	{
+		Region region(randomRect());
+		for (uint8_t jj = 0; jj < 6; jj++)
+		{
+			const Region before(region);
+			const Rect rect = randomRect();
+
+			Mask mask(region);
+			bool result;
+			switch (std::rand() % 3)
+			{
+				case 0:
+					result = region.unite(rect);
+					for (int16_t y = rect.getTop(); y <= int16_t(rect.getBottom()); y++)
+						for (int16_t x = rect.getLeft(); x <= int16_t(rect.getRight()); x++)
+							mask.pixels[y][x] = true;
+					break;
+				case 1:
+					result = region.intersect(rect);
+					for (int16_t y = 0; y < Height; y++)
+						for (int16_t x = 0; x < Width; x++)
+							mask.pixels[y][x] = mask.pixels[y][x] and rect.contains(x, y);
+					break;
+				default:
+					result = region.subtract(rect);
+					for (int16_t y = 0; y < Height; y++)
+						for (int16_t x = 0; x < Width; x++)
+							mask.pixels[y][x] = mask.pixels[y][x] and not rect.contains(x, y);
+					break;
+			}
+
+			if (result)
+			{
+				TEST_ASSERT_TRUE(isEqual(region, mask));
+				TEST_ASSERT_TRUE(isBanded(region));
+			}
+			else
+			{
+				TEST_ASSERT_TRUE(isEqual(region, Mask(before)));
+			}
+		}
+	}
+}
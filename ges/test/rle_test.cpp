@@ -0,0 +1,168 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#include <cstdlib>
+#include "rle_test.hpp"
+#include "../painter.hpp"
+#include "../image/rle_encoder.hpp"
+
+using namespace modm::ges;
+
+namespace
+{
+
+// longer than two runs of the maximum length
+constexpr uint16_t ImageWidth = 150;
+constexpr uint16_t ImageHeight = 20;
+
+// fills rows with random transparent, solid and noisy parts of up to 80 pixels
+template< PixelFormat Format >
+void
+fillRandom(Surface<Format> &image, const PixelColor<Format> transparent)
+{
+	for (uint16_t y = 0; y < image.getHeight(); y++)
+	{
+		uint16_t x = 0;
+		while (x < image.getWidth())
+		{
+			const uint16_t end = std::min<uint16_t>(x + 1 + std::rand() % 80, image.getWidth());
+			const uint8_t kind = std::rand() % 3;
+			const Color color(std::rand() % 256, std::rand() % 256, std::rand() % 256);
+			for (; x < end; x++)
+			{
+				if (kind == 0) image.setPixel(x, y, transparent);
+				else if (kind == 1) image.setPixel(x, y, PixelColor<Format>(color));
+				else image.setPixel(x, y, PixelColor<Format>(Color(std::rand() % 256, std::rand() % 256, std::rand() % 256)));
+			}
+		}
+	}
+}
+
+// Draws the encoded image onto a marked surface and compares every pixel to
+// the source image, or to the marker outside the clip region, outside the
+// image and for transparent pixels. Returns the number of wrong pixels.
+template< PixelFormat Format, typename Function >
+uint32_t
+compare(const Surface<Format> &image, const std::vector<uint8_t> &data, Function &&isTransparent,
+		const Point &destination, const Region *clip)
+{
+	using NativeColor = PixelColor<Format>;
+	static typename Surface<Format>::template Buffer<160, 60> buffer;
+	Surface<Format> surface(buffer);
+	Painter<Format> painter(surface);
+	const RleImage<Format> rle(image.getSize(), data.data());
+
+	const NativeColor marker(kColorFuchsia);
+	surface.clear(marker);
+	if (clip) painter.setClipRegion(*clip);
+	painter.drawImage(rle, destination, painter.A);
+
+	uint32_t errors = 0;
+	for (int16_t y = 0; y < surface.getHeight(); y++)
+	{
+		for (int16_t x = 0; x < surface.getWidth(); x++)
+		{
+			const int16_t sx = x - destination.getX(), sy = y - destination.getY();
+			NativeColor expected = marker;
+			if ((clip == nullptr or clip->contains(x, y)) and
+				sx >= 0 and sy >= 0 and sx < image.getWidth() and sy < image.getHeight() and
+				not isTransparent(image.getPixel(sx, sy)))
+				expected = image.getPixel(sx, sy);
+			errors += not (surface.getPixel(x, y) == expected);
+		}
+	}
+	return errors;
+}
+
+template< PixelFormat Format >
+void
+checkColorKey(uint32_t &errors, bool clipped)
+{
+	using NativeColor = PixelColor<Format>;
+	static typename Surface<Format>::template Buffer<ImageWidth, ImageHeight> buffer;
+	Surface<Format> image(buffer);
+	const NativeColor key(kColorBlack);
+	auto isKey = [key](const NativeColor pixel) { return pixel == key; };
+
+	for (uint8_t ii = 0; ii < 20; ii++)
+	{
+		fillRandom(image, key);
+		const std::vector<uint8_t> data = RleEncoder<Format>::encode(image, key);
+		if (not clipped)
+		{
+			errors += compare(image, data, isKey, Point(0, 0), nullptr);
+			continue;
+		}
+		for (uint8_t jj = 0; jj < 10; jj++)
+		{
+			Region clip(Rect(std::rand() % 80 - 10, std::rand() % 40 - 10, std::rand() % 120, std::rand() % 50));
+			clip.subtract(Rect(std::rand() % 120, std::rand() % 50, std::rand() % 40, std::rand() % 20));
+			const Point destination(std::rand() % 200 - 100, std::rand() % 60 - 20);
+			errors += compare(image, data, isKey, destination, &clip);
+		}
+	}
+}
+
+} // anonymous namespace
+
+void
+RleTest::testEncodedSize()
+{
+	using Encoder = RleEncoder<PixelFormat::RGB565>;
+	using Image = RleImage<PixelFormat::RGB565>;
+	static Surface<PixelFormat::RGB565>::Buffer<ImageWidth, ImageHeight> buffer;
+	Surface<PixelFormat::RGB565> image(buffer);
+
+	// every row is split into runs of at most the maximum length
+	const uint8_t runs = (ImageWidth + Image::MaxLength - 1) / Image::MaxLength;
+	image.clear(ColorRGB565(kColorRed));
+	TEST_ASSERT_EQUALS(Encoder::encode(image, ColorRGB565(kColorBlack)).size(), ImageHeight * runs * 3u);
+
+	// skip runs have no pixel values
+	image.clear(ColorRGB565(kColorBlack));
+	TEST_ASSERT_EQUALS(Encoder::encode(image, ColorRGB565(kColorBlack)).size(), ImageHeight * runs * 1u);
+
+	// different pixels are stored in literal runs
+	for (uint16_t x = 0; x < ImageWidth; x++) image.setPixel(x, 0, ColorRGB565(uint16_t(x + 1)));
+	const std::vector<uint8_t> data = Encoder::encode(image, ColorRGB565(kColorBlack));
+	TEST_ASSERT_EQUALS(data.size(), (ImageHeight - 1) * runs + runs + ImageWidth * 2u);
+	TEST_ASSERT_TRUE(Image::getRun(data[0]) == Image::Run::Literal);
+	TEST_ASSERT_EQUALS(Image::getLength(data[0]), Image::MaxLength);
+}
+
+void
+RleTest::testRoundTrip()
+{
+	std::srand(30);
+	uint32_t errors = 0;
+	checkColorKey<PixelFormat::RGB565>(errors, false);
+	checkColorKey<PixelFormat::L4>(errors, false);
+	checkColorKey<PixelFormat::RGB332>(errors, false);
+	TEST_ASSERT_EQUALS(errors, 0u);
+
+	// pixels without alpha are skipped
+	using NativeColor = PixelColor<PixelFormat::ARGB8>;
+	static Surface<PixelFormat::ARGB8>::Buffer<ImageWidth, ImageHeight> buffer;
+	Surface<PixelFormat::ARGB8> image(buffer);
+	auto isClear = [](const NativeColor pixel) { return static_cast<Color>(pixel).getAlpha() == 0; };
+	for (uint8_t ii = 0; ii < 20; ii++)
+	{
+		fillRandom(image, NativeColor(Color(0, 0, 0, 0)));
+		errors += compare(image, RleEncoder<PixelFormat::ARGB8>::encode(image), isClear, Point(0, 0), nullptr);
+	}
+	TEST_ASSERT_EQUALS(errors, 0u);
+}
+
+void
+RleTest::testClipping()
+{
+	std::srand(31);
+	uint32_t errors = 0;
+	checkColorKey<PixelFormat::RGB565>(errors, true);
+	checkColorKey<PixelFormat::L4>(errors, true);
+	TEST_ASSERT_EQUALS(errors, 0u);
+}
@@ -0,0 +1,208 @@
+/* Copyright (c) 2015, Niklas Hauser
+ * All Rights Reserved.
+ *
+ * The file is part of the upainter library and is released under the GPLv3
+ * license. See the file `LICENSE` for the full license governing this code.
+ * ------------------------------------------------------------------------ */
+
+#ifndef MODM_GES_TRACE_HPP
+#define MODM_GES_TRACE_HPP
+
+#include <stdint.h>
+
+#ifdef XPCC__OS_HOSTED
+#	include <atomic>
+#endif
+
+namespace modm
+{
+
+namespace ges
+{
+
+enum class
+TraceCategory : uint8_t
+{
+	Frame,
+	Painter,
+	Blit,
+	Conversion,
+	Flush,
+	User,
+};
+
+struct TraceEvent
+{
+	const char *name;	// static string, which is not copied
+	uint32_t begin;
+	uint32_t duration;
+	TraceCategory category;
+};
+
+// Records scoped events into a ring buffer of user supplied storage, which
+// keeps the latest events and overwrites the oldest ones.
+// There is one writer, typically the render loop, and it never waits on
+// readers: events overwritten while being read are dropped by the reader.
+// Events are numbered by a sequence that only ever increases, so that the
+// slot of an event is found with a mask and a reader can always tell if the
+// slot was reused, even across a clear.
+// The clock returns a free running time in microseconds.
+class Trace
+{
+public:
+	template< uint16_t Capacity >
+	Trace(TraceEvent (&events)[Capacity], uint32_t (*clock)()) :
+		events(events), mask(Capacity - 1), clock(clock)
+	{
+		static_assert(Capacity > 0 and (Capacity & (Capacity - 1)) == 0,
+					  "The trace capacity must be a power of two!");
+	}
+
+	inline uint32_t
+	now() const
+	{ return clock(); }
+
+	void
+	record(const char *name, TraceCategory category, uint32_t begin, uint32_t end)
+	{
+		const uint32_t index = written;
+		TraceEvent &event = events[index & mask];
+		event.name = name;
+		event.begin = begin;
+		event.duration = end - begin;
+		event.category = category;
+		publish(index + 1);
+	}
+
+	// forgets all events recorded so far
+	inline void
+	clear()
+	{ cleared = uint32_t(written); }
+
+	// number of events recorded since the last clear, including overwritten ones
+	inline uint32_t
+	getWritten() const
+	{ return written - cleared; }
+
+	// sequence of the oldest event still readable
+	inline uint32_t
+	getBegin() const
+	{
+		const uint32_t end = written;
+		return (end - cleared > getCapacity()) ? end - getCapacity() : uint32_t(cleared);
+	}
+
+	// sequence of the next event
+	inline uint32_t
+	getEnd() const
+	{ return written; }
+
+	inline uint32_t
+	getCapacity() const
+	{ return uint32_t(mask) + 1; }
+
+	// Copies event `index` out of the buffer, returns false if it was cleared,
+	// already overwritten or is overwritten while being copied.
+	bool
+	read(uint32_t index, TraceEvent &event) const
+	{
+		// the differences are unsigned, so the sequence may wrap around
+		if (index - cleared >= written - cleared) return false;
+		event = events[index & mask];
+		barrier();
+		// the slot is written again for the event `index + capacity`
+		return written - index <= mask;
+	}
+
+	static inline const char *
+	getName(TraceCategory category)
+	{
+		static constexpr const char *names[] = {
+			"frame", "painter", "blit", "conversion", "flush", "user" };
+		return names[uint8_t(category)];
+	}
+
+#ifdef XPCC__OS_HOSTED
+	// Writes all events still in the buffer as Chrome trace event JSON, which
+	// can be opened in chrome://tracing and the Perfetto UI.
+	template< typename Stream >
+	void
+	exportJson(Stream &stream) const
+	{
+		const uint32_t end = getEnd();
+		bool first = true;
+
+		stream << "{\"traceEvents\":[";
+		for (uint32_t ii = getBegin(); ii != end; ii++)
+		{
+			TraceEvent event;
+			if (not read(ii, event)) continue;
+			stream << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+				   << "\",\"cat\":\"" << getName(event.category)
+				   << "\",\"ph\":\"X\",\"ts\":" << event.begin << ",\"dur\":" << event.duration
+				   << ",\"pid\":1,\"tid\":1}";
+			first = false;
+		}
+		stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	}
+#endif
+
+protected:
+	// the event must be complete before it is counted
+	inline void
+	publish(uint32_t count)
+	{
+		barrier();
+		written = count;
+	}
+
+	static inline void
+	barrier()
+	{
+#ifdef XPCC__OS_HOSTED
+		std::atomic_thread_fence(std::memory_order_acq_rel);
+#else
+		asm volatile ("" ::: "memory");
+#endif
+	}
+
+private:
+	TraceEvent *const events;
+	const uint16_t mask;
+	uint32_t (*const clock)();
+#ifdef XPCC__OS_HOSTED
+	std::atomic<uint32_t> written{0};
+	std::atomic<uint32_t> cleared{0};
+#else
+	volatile uint32_t written{0};
+	volatile uint32_t cleared{0};
+#endif
+};
+
+// Records an event from construction to destruction, nothing without trace.
+class TraceScope
+{
+public:
+	inline
+	TraceScope(Trace *trace, const char *name, TraceCategory category = TraceCategory::User) :
+		trace(trace), name(name), begin(trace ? trace->now() : 0), category(category) {}
+
+	inline
+	~TraceScope()
+	{ if (trace) trace->record(name, category, begin, trace->now()); }
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope &operator = (const TraceScope&) = delete;
+
+private:
+	Trace *const trace;
+	const char *const name;
+	const uint32_t begin;
+	const TraceCategory category;
+};
+
+} // namespace ges
+
+} // namespace modm
+
+#endif // MODM_GES_TRACE_HPP
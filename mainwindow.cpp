@@ -31,7 +31,7 @@ MainWindow::MainWindow(QWidget *parent) :
 {
 	ui->setupUi(this);
 
-	this->setGeometry(0, 0, surface.getWidth() * 10+25, surface.getHeight()* 10+60);
+	this->setGeometry(0, 0, surface.getWidth() * QDisplay::Scale+25, surface.getHeight()* QDisplay::Scale+60);
 
 	QHBoxLayout *layout = new QHBoxLayout;
 	layout->addWidget(&qDisplay);
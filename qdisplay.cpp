@@ -29,13 +29,8 @@ toQImageFormat(PixelFormat format)
 
 		case PixelFormat::ARGB2:
 		case PixelFormat::RGB332:
-		case PixelFormat::ARGB1:
-		case PixelFormat::RGB1:
-		case PixelFormat::AL1:
-		case PixelFormat::L2:
-		case PixelFormat::AL2:
-		case PixelFormat::L4:
 		case PixelFormat::AL4:
+		case PixelFormat::I8:
 			return QImage::Format_Indexed8;
 
 		case PixelFormat::AL8:
@@ -60,8 +55,10 @@ toQImageFormat(PixelFormat format)
 	}
 }
 
-QDisplay::QDisplay(uchar *data, const uint16_t width, const uint16_t height, const PixelFormat format, QWidget *parent) :
-	QWidget(parent), image(data, width, height, toQImageFormat(format))
+QDisplay::QDisplay(const uint16_t width, const uint16_t height, const PixelFormat format, QWidget *parent) :
+	QWidget(parent), buffer(std::size_t(width) * height * bitsPerPixel(format) / 8),
+	// this needs uchar*, NOT const uchar *. The latter will call the wrong QImage constructor.
+	image(buffer.data(), width, height, width * bitsPerPixel(format) / 8, toQImageFormat(format))
 {
 	// manually create color tables and attach to image if necessary
 	if (format == PixelFormat::L1)
@@ -69,48 +66,6 @@ QDisplay::QDisplay(uchar *data, const uint16_t width, const uint16_t height, con
 		QVector<QRgb> table{qRgb(0,0,0), qRgb(0xff, 0xff, 0xff)};
 		image.setColorTable(table);
 	}
-	else if (format == PixelFormat::AL1)
-	{
-		QVector<QRgb> table
-		{
-			Color(ColorAL1(0b00)).getValue(),
-			Color(ColorAL1(0b01)).getValue(),
-			Color(ColorAL1(0b10)).getValue(),
-			Color(ColorAL1(0b11)).getValue(),
-		};
-		image.setColorTable(table);
-	}
-	else if (format == PixelFormat::L2)
-	{
-		QVector<QRgb> table
-		{
-			Color(ColorL2(0b00)).getValue(),
-			Color(ColorL2(0b01)).getValue(),
-			Color(ColorL2(0b10)).getValue(),
-			Color(ColorL2(0b11)).getValue(),
-		};
-		image.setColorTable(table);
-	}
-	else if (format == PixelFormat::AL2)
-	{
-		QVector<QRgb> table(16);
-		for(uint8_t i = 0; i < 16; i++)
-		{
-			Color c = Color(ColorAL2(i));
-			table[i] = c.getValue();
-		}
-		image.setColorTable(table);
-	}
-	else if (format == PixelFormat::L4)
-	{
-		QVector<QRgb> table(16);
-		for(uint8_t i = 0; i < 16; i++)
-		{
-			Color c = Color(ColorL4(i));
-			table[i] = c.getValue();
-		}
-		image.setColorTable(table);
-	}
 	else if (format == PixelFormat::AL4)
 	{
 		QVector<QRgb> table(256);
@@ -121,44 +76,6 @@ QDisplay::QDisplay(uchar *data, const uint16_t width, const uint16_t height, con
 		}
 		image.setColorTable(table);
 	}
-	else if (format == PixelFormat::RGB1)
-	{
-		QVector<QRgb> table
-		{
-			qRgb(0, 0, 0),
-			qRgb(0, 0, 0xff),
-			qRgb(0, 0xff, 0),
-			qRgb(0, 0xff, 0xff),
-			qRgb(0xff, 0, 0),
-			qRgb(0xff, 0, 0xff),
-			qRgb(0xff, 0xff, 0),
-			qRgb(0xff, 0xff, 0xff)
-		};
-		image.setColorTable(table);
-	}
-	else if (format == PixelFormat::ARGB1)
-	{
-		QVector<QRgb> table
-		{
-			qRgba(0, 0, 0, 0),
-			qRgba(0, 0, 0xff, 0),
-			qRgba(0, 0xff, 0, 0),
-			qRgba(0, 0xff, 0xff, 0),
-			qRgba(0xff, 0, 0, 0),
-			qRgba(0xff, 0, 0xff, 0),
-			qRgba(0xff, 0xff, 0, 0),
-			qRgba(0xff, 0xff, 0xff, 0),
-			qRgb(0, 0, 0),
-			qRgb(0, 0, 0xff),
-			qRgb(0, 0xff, 0),
-			qRgb(0, 0xff, 0xff),
-			qRgb(0xff, 0, 0),
-			qRgb(0xff, 0, 0xff),
-			qRgb(0xff, 0xff, 0),
-			qRgb(0xff, 0xff, 0xff)
-		};
-		image.setColorTable(table);
-	}
 	else if (format == PixelFormat::RGB332)
 	{
 		QVector<QRgb> table(256);
@@ -169,6 +86,17 @@ QDisplay::QDisplay(uchar *data, const uint16_t width, const uint16_t height, con
 		}
 		image.setColorTable(table);
 	}
+	else if (format == PixelFormat::I8)
+	{
+		// the palette must be set before the display is created
+		const Palette *palette = ColorI8::getPalette();
+		QVector<QRgb> table(256, qRgb(0, 0, 0));
+		for(int i = 0; palette and i < palette->getCount(); i++)
+		{
+			table[i] = palette->getColor(i).getValue();
+		}
+		image.setColorTable(table);
+	}
 	else if (format == PixelFormat::ARGB2)
 	{
 		QVector<QRgb> table(256);
@@ -184,8 +112,13 @@ QDisplay::QDisplay(uchar *data, const uint16_t width, const uint16_t height, con
 void
 QDisplay::paintEvent(QPaintEvent */*event*/)
 {
+	{
+		const TraceScope scope(trace, "upscale", TraceCategory::Conversion);
+		upscale();
+	}
+
+	const TraceScope scope(trace, "paint", TraceCategory::Flush);
 	QPainter painter(this);
-	painter.scale(10, 10);
 	painter.drawImage(0, 0, image);
 	painter.end();
 }
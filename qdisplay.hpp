@@ -10,8 +10,12 @@
 
 #include <QGraphicsView>
 #include <QImage>
+#include <vector>
+#include <functional>
 #include <ges/pixel_buffer.hpp>
 #include <ges/surface.hpp>
+#include <ges/painter.hpp>
+#include <ges/trace.hpp>
 
 namespace modm
 {
@@ -24,21 +28,47 @@ class QDisplay : public QWidget
 	Q_OBJECT
 
 public:
+	static constexpr uint8_t Scale = 10;
+
 	template< PixelFormat Format >
 	QDisplay(const Surface<Format> &surface, QWidget *parent = 0) :
-		QDisplay((uchar*)surface.buffer, surface.width, surface.height, surface.getPixelFormat(), parent)
-	{}
+		QDisplay(surface.getWidth() * Scale, surface.getHeight() * Scale, getDisplayFormat(Format), parent)
+	{
+		// the surface is enlarged in its own format, so Qt does not need to scale on every repaint,
+		// except for packed formats that QImage cannot show, which are converted to RGB8,
+		// and indices with alpha, which are converted to ARGB8
+		constexpr PixelFormat DisplayFormat = getDisplayFormat(Format);
+		Surface<DisplayFormat> scaled(buffer.data(), surface.getWidth() * Scale, surface.getHeight() * Scale);
+		upscale = [&surface, scaled]() mutable
+		{
+			Painter<DisplayFormat>(scaled).drawImageScaled(surface, Point(0, 0), Scale);
+		};
+	}
+
+	// records the conversion into the upscaled image and the flush to the screen
+	inline void
+	setTrace(Trace *trace)
+	{ this->trace = trace; }
 
 protected:
-	// this needs uchar*, NOT const uchar *. The latter will call the wrong QImage constructor.
-	QDisplay(uchar *data, const uint16_t width, const uint16_t height, const PixelFormat format, QWidget *parent = 0);
+	static constexpr PixelFormat
+	getDisplayFormat(PixelFormat format)
+	{
+		return (format == PixelFormat::AI4 or format == PixelFormat::AI8) ? PixelFormat::ARGB8 :
+			   (bitsPerPixel(format) == 2 or bitsPerPixel(format) == 4) ? PixelFormat::RGB8 : format;
+	}
+
+	QDisplay(const uint16_t width, const uint16_t height, const PixelFormat format, QWidget *parent = 0);
 
 private:
 	void
 	paintEvent(QPaintEvent *event) Q_DECL_OVERRIDE;
 
 private:
+	std::vector<uchar> buffer;
 	QImage image;
+	std::function<void()> upscale;
+	Trace *trace{nullptr};
 };
 
 } // namespace ges